@@ -0,0 +1,127 @@
+#include "ofApp.h"
+
+//--------------------------------------------------------------
+void ofApp::setup(){
+    numChains = 8;
+    ticks = 2000;
+    //Independent chains are ticked in parallel on the pool, the outputs have to be the same as a serial tick
+    graph serial = createGraph(1);
+    graph parallel = createGraph(4);
+    
+    int mismatches = 0;
+    for(int i = 0; i < ticks; i++){
+        float phasor = fmod(i * 0.0137f, 1.0f);
+        tick(serial, phasor);
+        tick(parallel, phasor);
+        for(int j = 0; j < numChains; j++){
+            auto &serialOutput = serial.outputs[j]->getParameters()->get<ofxOceanodeBuffer>("Output").get();
+            auto &parallelOutput = parallel.outputs[j]->getParameters()->get<ofxOceanodeBuffer>("Output").get();
+            if(serialOutput != parallelOutput){
+                mismatches++;
+            }
+        }
+    }
+    if(mismatches == 0){
+        ofLog() << "Serial and parallel ticks are equal, " << ticks << " ticks of " << numChains << " chains";
+    }else{
+        ofLogError() << "Serial and parallel ticks differ in " << mismatches << " outputs";
+    }
+    ofExit(mismatches == 0 ? 0 : 1);
+}
+
+//--------------------------------------------------------------
+ofApp::graph ofApp::createGraph(int threads){
+    graph g;
+    g.container = make_shared<ofxOceanodeContainer>(make_shared<ofxOceanodeNodeRegistry>(), make_shared<ofxOceanodeTypesRegistry>(), true);
+    g.container->setEngineThreads(threads);
+    for(int i = 0; i < numChains; i++){
+        auto bank = g.container->createNodeFromName("Oscillator Bank");
+        auto mapper = g.container->createNodeFromName("Mapper");
+        //All the waves, half of them with random addition, seeded so both graphs draw the same numbers
+        bank->getParameters()->getGroup("Wave").getInt(1) = i % 8;
+        bank->getParameters()->get<vector<float>>("Random Addition") = {i % 2 == 0 ? 0.0f : 0.25f};
+        bank->getParameters()->get<vector<int>>("Seed") = {i + 1};
+        mapper->getParameters()->getFloat("MaxOutput") = 0.5;
+        
+        string bankName = "Oscillator_Bank_" + ofToString(bank->getNodeModel().getNumIdentifier());
+        string mapperName = "Mapper_" + ofToString(mapper->getNodeModel().getNumIdentifier());
+        g.container->createConnectionFromInfo(bankName, "Oscillator Out", mapperName, "Input");
+        g.banks.push_back(bank);
+        g.outputs.push_back(mapper);
+    }
+    return g;
+}
+
+//--------------------------------------------------------------
+void ofApp::tick(graph &g, float phasor){
+    for(auto bank : g.banks){
+        bank->getParameters()->getFloat("Phasor In") = phasor;
+    }
+    //A headless container without threaded engine ticks on update
+    ofEventArgs args;
+    g.container->update(args);
+}
+
+//--------------------------------------------------------------
+void ofApp::update(){
+}
+
+//--------------------------------------------------------------
+void ofApp::draw(){
+
+}
+
+//--------------------------------------------------------------
+void ofApp::keyPressed(int key){
+    
+}
+
+//--------------------------------------------------------------
+void ofApp::keyReleased(int key){
+
+}
+
+//--------------------------------------------------------------
+void ofApp::mouseMoved(int x, int y ){
+
+}
+
+//--------------------------------------------------------------
+void ofApp::mouseDragged(int x, int y, int button){
+
+}
+
+//--------------------------------------------------------------
+void ofApp::mousePressed(int x, int y, int button){
+
+}
+
+//--------------------------------------------------------------
+void ofApp::mouseReleased(int x, int y, int button){
+
+}
+
+//--------------------------------------------------------------
+void ofApp::mouseEntered(int x, int y){
+
+}
+
+//--------------------------------------------------------------
+void ofApp::mouseExited(int x, int y){
+
+}
+
+//--------------------------------------------------------------
+void ofApp::windowResized(int w, int h){
+
+}
+
+//--------------------------------------------------------------
+void ofApp::gotMessage(ofMessage msg){
+
+}
+
+//--------------------------------------------------------------
+void ofApp::dragEvent(ofDragInfo dragInfo){ 
+
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include "ofMain.h"
+#include "ofxOceanode.h"
+
+class ofApp : public ofBaseApp{
+
+	public:
+		void setup();
+		void update();
+		void draw();
+
+		void keyPressed(int key);
+		void keyReleased(int key);
+		void mouseMoved(int x, int y );
+		void mouseDragged(int x, int y, int button);
+		void mousePressed(int x, int y, int button);
+		void mouseReleased(int x, int y, int button);
+		void mouseEntered(int x, int y);
+		void mouseExited(int x, int y);
+		void windowResized(int w, int h);
+		void dragEvent(ofDragInfo dragInfo);
+		void gotMessage(ofMessage msg);
+    
+    //The same graph in a headless container, ticked by hand
+    struct graph{
+        shared_ptr<ofxOceanodeContainer> container;
+        vector<ofxOceanodeNode*> banks;
+        vector<ofxOceanodeNode*> outputs;
+    };
+    graph createGraph(int threads);
+    void tick(graph &g, float phasor);
+    
+    int numChains;
+    int ticks;
+		
+};
@@ -0,0 +1,239 @@
+#include "ofApp.h"
+
+//--------------------------------------------------------------
+void ofApp::setup(){
+    //Replays a recorded 24 ppqn clock stream (jitter, tempo change, stop, song position, continue) in real time
+    //through the container, a phasor at the container bpm has to follow the beat position of the pulses
+    stream = loadStream("midiClockStream.txt");
+    if(stream.empty()){
+        ofLogError() << "Can't read the clock stream";
+        ofExit(1);
+        return;
+    }
+    
+    auto container = make_shared<ofxOceanodeContainer>(make_shared<ofxOceanodeNodeRegistry>(), make_shared<ofxOceanodeTypesRegistry>(), true);
+    auto node = container->createNodeFromName("Phasor");
+    auto &ph = dynamic_cast<phasor&>(node->getNodeModel());
+    ph.setBeatDiv(1);
+    ph.setBeatMult(1);
+    
+    //Ends of the steady tempo sections of the recording
+    vector<double> bpmChecks = {5.9, 10.9, 15.9};
+    size_t nextBpmCheck = 0;
+    //The transport advances from the last pulse, the error is below a pulse
+    double maxPhaseError = 1.0 / ofxOceanodeMidiClock::pulsesPerQuarter;
+    double maxBpmError = 0.5;
+    
+    refPulses = 0;
+    refRunning = false;
+    refWaitingFirstPulse = false;
+    refStarted = false;
+    refPulseTime = 0;
+    refNextPulseTime = 0;
+    
+    int failures = 0;
+    int phaseChecks = 0;
+    double phaseError = 0;
+    startTime = ofxOceanodeClock::now() + 0.1;
+    for(size_t i = 0; i < stream.size(); i++){
+        double time = startTime + stream[i].time;
+        sleepUntil(time);
+        container->receiveMidiClockMessage(stream[i].message, time);
+        referenceMessage(i);
+        
+        auto &midiClock = container->getMidiClock();
+        if(nextBpmCheck < bpmChecks.size() && stream[i].time >= bpmChecks[nextBpmCheck]){
+            double expected = referenceBpm(i);
+            if(std::abs(midiClock.getBpm() - expected) > maxBpmError){
+                ofLogError() << "At " << stream[i].time << "s the clock is at " << midiClock.getBpm() << " bpm, the stream at " << expected;
+                failures++;
+            }else{
+                ofLog() << "At " << stream[i].time << "s the clock is at " << midiClock.getBpm() << " bpm, the stream at " << expected;
+            }
+            nextBpmCheck++;
+        }
+        
+        //Compare halfway to the next message once the clock thread has seen this one
+        if(i + 1 < stream.size() && stream[i + 1].time - stream[i].time > 0.004 && refStarted && midiClock.isLocked()){
+            sleepUntil(startTime + (stream[i].time + stream[i + 1].time) / 2);
+            double phase = ph.getPhasor();
+            double expected = fmod(referenceBeat(ofxOceanodeClock::now() - startTime), 1.0);
+            double error = std::abs(phase - expected);
+            error = std::min(error, 1 - error);
+            phaseError = std::max(phaseError, error);
+            phaseChecks++;
+            if(error > maxPhaseError){
+                ofLogError() << "At " << stream[i].time << "s the phasor is at " << phase << ", the stream at " << expected;
+                failures++;
+            }
+        }
+    }
+    ofLog() << phaseChecks << " phase checks, max error " << phaseError << " beats";
+    
+    if(failures == 0){
+        ofLog() << "The phasor follows the clock stream";
+    }else{
+        ofLogError() << failures << " checks failed";
+    }
+    ofExit(failures == 0 ? 0 : 1);
+}
+
+//--------------------------------------------------------------
+vector<ofApp::clockMessage> ofApp::loadStream(string path){
+    vector<clockMessage> messages;
+    ofBuffer buffer = ofBufferFromFile(path);
+    for(auto line : buffer.getLines()){
+        if(line.empty() || line[0] == '#') continue;
+        auto tokens = ofSplitString(line, " ", true, true);
+        if(tokens.size() < 2) continue;
+        clockMessage m;
+        m.time = ofToDouble(tokens[0]);
+        for(int i = 1; i < tokens.size(); i++){
+            m.message.bytes.push_back(ofHexToInt(tokens[i]));
+        }
+        m.message.status = (MidiStatus)m.message.bytes[0];
+        messages.push_back(m);
+    }
+    return messages;
+}
+
+//--------------------------------------------------------------
+void ofApp::sleepUntil(double time){
+    double wait = time - ofxOceanodeClock::now();
+    if(wait > 0){
+        std::this_thread::sleep_for(std::chrono::duration<double>(wait));
+    }
+}
+
+//--------------------------------------------------------------
+void ofApp::referenceMessage(size_t index){
+    switch(stream[index].message.status){
+        case MIDI_TIME_CLOCK:
+            refPulseTime = stream[index].time;
+            refNextPulseTime = refPulseTime;
+            for(size_t i = index + 1; i < stream.size(); i++){
+                if(stream[i].message.status == MIDI_TIME_CLOCK){
+                    refNextPulseTime = stream[i].time;
+                    break;
+                }
+            }
+            if(refRunning){
+                if(refWaitingFirstPulse){
+                    refWaitingFirstPulse = false;
+                }else{
+                    refPulses++;
+                }
+            }
+            break;
+        case MIDI_START:
+            refRunning = true;
+            refWaitingFirstPulse = true;
+            refStarted = true;
+            refPulses = 0;
+            break;
+        case MIDI_CONTINUE:
+            refRunning = true;
+            refWaitingFirstPulse = true;
+            break;
+        case MIDI_STOP:
+            refRunning = false;
+            break;
+        case MIDI_SONG_POS_POINTER:
+            refPulses = (long long)(stream[index].message.bytes[1] | (stream[index].message.bytes[2] << 7)) * 6;
+            refWaitingFirstPulse = true;
+            break;
+        default:
+            break;
+    }
+}
+
+//--------------------------------------------------------------
+double ofApp::referenceBeat(double time){
+    double position = (double)refPulses;
+    if(refRunning && !refWaitingFirstPulse && refNextPulseTime > refPulseTime){
+        position += ofClamp((time - refPulseTime) / (refNextPulseTime - refPulseTime), 0, 1);
+    }
+    return position / ofxOceanodeMidiClock::pulsesPerQuarter;
+}
+
+//--------------------------------------------------------------
+double ofApp::referenceBpm(size_t index){
+    //Average of the last two beats of pulses
+    int intervals = ofxOceanodeMidiClock::pulsesPerQuarter * 2;
+    double last = -1;
+    double first = -1;
+    int count = 0;
+    for(int i = index; i >= 0 && count <= intervals; i--){
+        if(stream[i].message.status == MIDI_TIME_CLOCK){
+            if(last < 0) last = stream[i].time;
+            first = stream[i].time;
+            count++;
+        }
+    }
+    if(count < 2) return 0;
+    return 60.0 / ((last - first) / (count - 1) * ofxOceanodeMidiClock::pulsesPerQuarter);
+}
+
+//--------------------------------------------------------------
+void ofApp::update(){
+}
+
+//--------------------------------------------------------------
+void ofApp::draw(){
+
+}
+
+//--------------------------------------------------------------
+void ofApp::keyPressed(int key){
+    
+}
+
+//--------------------------------------------------------------
+void ofApp::keyReleased(int key){
+
+}
+
+//--------------------------------------------------------------
+void ofApp::mouseMoved(int x, int y ){
+
+}
+
+//--------------------------------------------------------------
+void ofApp::mouseDragged(int x, int y, int button){
+
+}
+
+//--------------------------------------------------------------
+void ofApp::mousePressed(int x, int y, int button){
+
+}
+
+//--------------------------------------------------------------
+void ofApp::mouseReleased(int x, int y, int button){
+
+}
+
+//--------------------------------------------------------------
+void ofApp::mouseEntered(int x, int y){
+
+}
+
+//--------------------------------------------------------------
+void ofApp::mouseExited(int x, int y){
+
+}
+
+//--------------------------------------------------------------
+void ofApp::windowResized(int w, int h){
+
+}
+
+//--------------------------------------------------------------
+void ofApp::gotMessage(ofMessage msg){
+
+}
+
+//--------------------------------------------------------------
+void ofApp::dragEvent(ofDragInfo dragInfo){ 
+
+}
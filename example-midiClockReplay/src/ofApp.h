@@ -0,0 +1,49 @@
+#pragma once
+
+#include "ofMain.h"
+#include "ofxOceanode.h"
+#include "ofxMidi.h"
+#include "phasor.h"
+
+class ofApp : public ofBaseApp{
+
+	public:
+		void setup();
+		void update();
+		void draw();
+
+		void keyPressed(int key);
+		void keyReleased(int key);
+		void mouseMoved(int x, int y );
+		void mouseDragged(int x, int y, int button);
+		void mousePressed(int x, int y, int button);
+		void mouseReleased(int x, int y, int button);
+		void mouseEntered(int x, int y);
+		void mouseExited(int x, int y);
+		void windowResized(int w, int h);
+		void dragEvent(ofDragInfo dragInfo);
+		void gotMessage(ofMessage msg);
+    
+    //A message of the recorded clock stream, time in seconds since the first message
+    struct clockMessage{
+        double time;
+        ofxMidiMessage message;
+    };
+    vector<clockMessage> loadStream(string path);
+    void sleepUntil(double time);
+    
+    //Beat position counted straight from the recorded pulses, what the filtered clock has to follow. Stream times
+    void referenceMessage(size_t index);
+    double referenceBeat(double time);
+    double referenceBpm(size_t index);
+    
+    vector<clockMessage> stream;
+    double startTime; //ofxOceanodeClock::now() of the first message
+    long long refPulses;
+    bool refRunning;
+    bool refWaitingFirstPulse;
+    bool refStarted;
+    double refPulseTime;
+    double refNextPulseTime;
+		
+};
@@ -0,0 +1,132 @@
+#include "ofApp.h"
+
+//--------------------------------------------------------------
+void ofApp::setup(){
+    bankSize = 1024;
+    iterations = 4000;
+    if(!baseOscillatorBank::fastMathAvailable()){
+        ofLog() << "Built without SIMD, oscillator banks don't have fast math";
+        ofExit();
+        return;
+    }
+    ofLog() << "Oscillator bank of " << bankSize << ", ns per oscillator and max error of fast math against libm";
+    //tri and saw are exact in both modes, so the pow errors are only from the approximation
+    benchmark("sin", 0, 0, 0);
+    benchmark("cos", 1, 0, 0);
+    benchmark("tri pow 40", 2, 40, 0);
+    benchmark("tri pow -40", 2, -40, 0);
+    benchmark("tri bipow 40", 2, 0, 40);
+    benchmark("saw bipow -40", 4, 0, -40);
+    benchmark("sin pow 4 bipow 2", 0, 4, 2);
+    //Negative exponents amplify the last float step of sin and cos next to the troughs, in both modes,
+    //only a few outputs that close to a trough go over 8 bit resolution
+    benchmark("sin pow -40", 0, -40, 0);
+    benchmark("cos pow -40", 1, -40, 0);
+    benchmark("sin bipow -40", 0, 0, -40);
+    benchmark("cos bipow -40", 1, 0, -40);
+    ofExit();
+}
+
+//--------------------------------------------------------------
+void ofApp::benchmark(string name, int wave, float pow, float biPow){
+    vector<float> indexs(bankSize);
+    for(int i = 0; i < bankSize; i++){
+        indexs[i] = (float)i / bankSize;
+    }
+    baseOscillatorBank banks[2];
+    vector<float> outputs[2];
+    double nanoseconds[2];
+    for(int mode = 0; mode < 2; mode++){
+        banks[mode].resize(bankSize);
+        banks[mode].setIndexNormalized(indexs);
+        banks[mode].setWaveSelect(wave);
+        banks[mode].setPow({pow});
+        banks[mode].setBiPow({biPow});
+        banks[mode].setFastMath(mode == 1);
+        outputs[mode].resize(bankSize);
+        
+        auto start = std::chrono::steady_clock::now();
+        for(int i = 0; i < iterations; i++){
+            banks[mode].compute((float)i / iterations, outputs[mode].data());
+        }
+        nanoseconds[mode] = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / ((double)iterations * bankSize);
+    }
+    
+    float maxError = 0;
+    int over8Bit = 0;
+    for(int i = 0; i < iterations; i++){
+        float phasor = ofRandom(1);
+        banks[0].compute(phasor, outputs[0].data());
+        banks[1].compute(phasor, outputs[1].data());
+        for(int j = 0; j < bankSize; j++){
+            float error = fabs(outputs[0][j] - outputs[1][j]);
+            maxError = max(maxError, error);
+            if(error > 1.0f / 255) over8Bit++;
+        }
+    }
+    ofLog() << name << ": libm " << nanoseconds[0] << " ns, fast " << nanoseconds[1] << " ns, x" << nanoseconds[0] / nanoseconds[1] << ", max error " << maxError << ", " << over8Bit << " of " << iterations * bankSize << " outputs over 1/255";
+}
+
+//--------------------------------------------------------------
+void ofApp::update(){
+}
+
+//--------------------------------------------------------------
+void ofApp::draw(){
+
+}
+
+//--------------------------------------------------------------
+void ofApp::keyPressed(int key){
+    
+}
+
+//--------------------------------------------------------------
+void ofApp::keyReleased(int key){
+
+}
+
+//--------------------------------------------------------------
+void ofApp::mouseMoved(int x, int y ){
+
+}
+
+//--------------------------------------------------------------
+void ofApp::mouseDragged(int x, int y, int button){
+
+}
+
+//--------------------------------------------------------------
+void ofApp::mousePressed(int x, int y, int button){
+
+}
+
+//--------------------------------------------------------------
+void ofApp::mouseReleased(int x, int y, int button){
+
+}
+
+//--------------------------------------------------------------
+void ofApp::mouseEntered(int x, int y){
+
+}
+
+//--------------------------------------------------------------
+void ofApp::mouseExited(int x, int y){
+
+}
+
+//--------------------------------------------------------------
+void ofApp::windowResized(int w, int h){
+
+}
+
+//--------------------------------------------------------------
+void ofApp::gotMessage(ofMessage msg){
+
+}
+
+//--------------------------------------------------------------
+void ofApp::dragEvent(ofDragInfo dragInfo){ 
+
+}
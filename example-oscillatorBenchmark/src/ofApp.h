@@ -0,0 +1,31 @@
+#pragma once
+
+#include "ofMain.h"
+#include "baseOscillatorBank.h"
+
+class ofApp : public ofBaseApp{
+
+	public:
+		void setup();
+		void update();
+		void draw();
+
+		void keyPressed(int key);
+		void keyReleased(int key);
+		void mouseMoved(int x, int y );
+		void mouseDragged(int x, int y, int button);
+		void mousePressed(int x, int y, int button);
+		void mouseReleased(int x, int y, int button);
+		void mouseEntered(int x, int y);
+		void mouseExited(int x, int y);
+		void windowResized(int w, int h);
+		void dragEvent(ofDragInfo dragInfo);
+		void gotMessage(ofMessage msg);
+    
+    //Times a bank with libm and with fast math and compares their outputs
+    void benchmark(string name, int wave, float pow, float biPow);
+    
+    int bankSize;
+    int iterations;
+		
+};
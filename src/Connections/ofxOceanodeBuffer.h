@@ -0,0 +1,94 @@
+//
+//  ofxOceanodeBuffer.h
+//  ofxOceanode
+//
+
+#ifndef ofxOceanodeBuffer_h
+#define ofxOceanodeBuffer_h
+
+#include "ofParameter.h"
+#include <memory>
+
+//Shared, reference counted float values for ofParameter<ofxOceanodeBuffer>. Copies share the values,
+//so a connection hands the buffer to its sink by pointer. Shared values are never modified, edit() copies them first.
+class ofxOceanodeBuffer{
+public:
+    ofxOceanodeBuffer(){};
+    ofxOceanodeBuffer(std::initializer_list<float> values) : values(std::make_shared<vector<float>>(values)){};
+    explicit ofxOceanodeBuffer(vector<float> values) : values(std::make_shared<vector<float>>(std::move(values))){};
+
+    const vector<float>& get() const{
+        static const vector<float> empty;
+        return values ? *values : empty;
+    }
+    size_t size() const{return get().size();};
+    bool empty() const{return get().empty();};
+    const float* data() const{return get().data();};
+    float operator[](size_t i) const{return get()[i];};
+    vector<float>::const_iterator begin() const{return get().begin();};
+    vector<float>::const_iterator end() const{return get().end();};
+
+    //True when no other buffer shares the values
+    bool unique() const{return values.use_count() == 1;};
+
+    //Copy on write, the values are copied unless this buffer is their only owner
+    vector<float>& edit(){
+        if(!values){
+            values = std::make_shared<vector<float>>();
+        }else if(!unique()){
+            values = std::make_shared<vector<float>>(*values);
+        }
+        return *values;
+    }
+
+    bool operator==(const ofxOceanodeBuffer &other) const{
+        return values == other.values || get() == other.get();
+    }
+    bool operator!=(const ofxOceanodeBuffer &other) const{
+        return !(*this == other);
+    }
+
+private:
+    std::shared_ptr<vector<float>> values;
+};
+
+//Output of a node publishing buffers, keeps the buffer it published before the last one and writes the next values
+//in it once the sinks have moved on, so a stable chain reuses two allocations instead of allocating every tick
+class ofxOceanodeBufferWriter{
+public:
+    //Storage of the next buffer, sized but with the old values
+    vector<float>& resize(size_t size){
+        vector<float> &values = next.edit();
+        values.resize(size);
+        return values;
+    }
+
+    void publish(ofParameter<ofxOceanodeBuffer> &p){
+        ofxOceanodeBuffer previous = p.get();
+        p = next;
+        next = std::move(previous);
+    }
+
+private:
+    ofxOceanodeBuffer next;
+};
+
+//Same text as ofToString of a vector of floats, "{0, 0.5, 1}", read back by operator>>
+inline std::ostream& operator<<(std::ostream &os, const ofxOceanodeBuffer &buffer){
+    return os << ofToString(buffer.get());
+}
+
+inline std::istream& operator>>(std::istream &is, ofxOceanodeBuffer &buffer){
+    string text;
+    std::getline(is, text);
+    vector<float> values;
+    for(auto &value : ofSplitString(text, ",", true, true)){
+        ofStringReplace(value, "{", "");
+        ofStringReplace(value, "}", "");
+        if(!value.empty()) values.push_back(ofToFloat(value));
+    }
+    buffer = ofxOceanodeBuffer(std::move(values));
+    return is;
+}
+
+#endif /* ofxOceanodeBuffer_h */
@@ -23,10 +23,11 @@ void ofxOceanodeConnection<void, bool>::linkParameters(){
 }
 
 template<>
-void ofxOceanodeConnection<float, bool>::linkParameters(){
-    parameterEventListener = sourceParameter.newListener([&](float &f){
-        bool newValue = (f > ((sourceParameter.getMax() - sourceParameter.getMin())/2.0 + sourceParameter.getMin())) ? true : false;
-        if(newValue != sinkParameter) sinkParameter = newValue;
-    });
+void ofxOceanodeConnection<float, bool>::propagate(){
+    if(!pending) return;
+    pending = false;
+    float f = sourceParameter;
+    bool newValue = (f > ((sourceParameter.getMax() - sourceParameter.getMin())/2.0 + sourceParameter.getMin())) ? true : false;
+    if(newValue != sinkParameter) sinkParameter = newValue;
 }
 
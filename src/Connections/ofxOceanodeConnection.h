@@ -10,22 +10,45 @@
 
 #include "ofMain.h"
 #include "ofxOceanodeConnectionGraphics.h"
+#include "ofxOceanodeBuffer.h"
+
+class ofxOceanodeNode;
+
+//Stable reference to a connection stored in the container, it stops resolving once the connection is destroyed
+struct ofxOceanodeConnectionHandle{
+    uint32_t index = std::numeric_limits<uint32_t>::max();
+    uint32_t generation = 0;
+};
 
 class ofxOceanodeAbstractConnection{
 public:
     ofxOceanodeAbstractConnection(ofAbstractParameter& _sourceParameter, ofAbstractParameter& _sinkParameter){
         sourceParameter = &_sourceParameter;
         sinkParameter = &_sinkParameter;
+        sourceNode = nullptr;
+        sinkNode = nullptr;
+        sourceNodeIndex = -1;
+        sinkNodeIndex = -1;
+        pending = false;
         isPersistent = false;
     };
     
     ofxOceanodeAbstractConnection(ofAbstractParameter& _sourceParameter){
         sourceParameter = &_sourceParameter;
         sinkParameter = nullptr;
+        sourceNode = nullptr;
+        sinkNode = nullptr;
+        sourceNodeIndex = -1;
+        sinkNodeIndex = -1;
+        pending = false;
         isPersistent = false;
     };
     virtual ~ofxOceanodeAbstractConnection(){};
     
+    //Source changes are only flagged, the value is copied to the sink when the container tick reaches the sink node
+    virtual void propagate(){};
+    bool isPending(){return pending;};
+    
     void setSourcePosition(glm::vec2 posVec){
         graphics.setPoint(0, posVec);
     }
@@ -50,6 +73,19 @@ public:
     ofAbstractParameter& getSourceParameter(){return *sourceParameter;};
     ofAbstractParameter& getSinkParameter(){return *sinkParameter;};
     
+    ofxOceanodeNode* getSourceNode(){return sourceNode;};
+    ofxOceanodeNode* getSinkNode(){return sinkNode;};
+    void setSourceNode(ofxOceanodeNode* n){sourceNode = n;};
+    void setSinkNode(ofxOceanodeNode* n){sinkNode = n;};
+    //Position of the connection in the out list of its source node and in the in list of its sink node
+    int getSourceNodeIndex(){return sourceNodeIndex;};
+    int getSinkNodeIndex(){return sinkNodeIndex;};
+    void setSourceNodeIndex(int i){sourceNodeIndex = i;};
+    void setSinkNodeIndex(int i){sinkNodeIndex = i;};
+    
+    ofxOceanodeConnectionHandle getHandle(){return handle;};
+    void setHandle(ofxOceanodeConnectionHandle h){handle = h;};
+    
     bool getIsPersistent(){return isPersistent;};
     void setIsPersistent(bool p){isPersistent = p;graphics.setWireColor(ofColor(255,0,0));};
         
@@ -60,12 +96,18 @@ protected:
     ofAbstractParameter* sourceParameter;
     ofAbstractParameter* sinkParameter;
     
+    ofxOceanodeNode* sourceNode;
+    ofxOceanodeNode* sinkNode;
+    int sourceNodeIndex;
+    int sinkNodeIndex;
+    ofxOceanodeConnectionHandle handle;
+    
+    bool pending;
+    
 private:
     bool isPersistent;
 };
 
-class ofxOceanodeNode;
-
 class ofxOceanodeTemporalConnection: public ofxOceanodeAbstractConnection{
 public:
     ofxOceanodeTemporalConnection(ofAbstractParameter& _p) : ofxOceanodeAbstractConnection(_p){
@@ -101,10 +143,17 @@ public:
         ofNotifyEvent(destroyConnection);
     };
     
+    void propagate() override{
+        if(!pending) return;
+        pending = false;
+        //Buffers are shared, the sink gets the source values by pointer. Vectors are copied
+        sinkParameter = sourceParameter;
+    }
+    
 private:
     void linkParameters(){
         parameterEventListener = sourceParameter.newListener([&](Tsource &p){
-            sinkParameter = sourceParameter;
+            pending = true;
         });
         //sinkParameter = sourceParameter;
     }
@@ -114,18 +163,21 @@ private:
     Tsink beforeConnectionValue;
 };
 
+//Element conversion between vector types, plain loop over raw pointers so the compiler can vectorize the float<->int conversion
+template<typename _Tsource, typename _Tsink>
+inline void ofxOceanodeConvertBuffer(const _Tsource * __restrict source, _Tsink * __restrict sink, size_t size){
+    for(size_t i = 0; i < size; i++){
+        sink[i] = static_cast<_Tsink>(source[i]);
+    }
+}
+
 template<typename _Tsource, typename _Tsink>
 class ofxOceanodeConnection<vector<_Tsource>, vector<_Tsink>, typename std::enable_if<!std::is_same<_Tsource, _Tsink>::value>::type>: public ofxOceanodeAbstractConnection{
 public:
     ofxOceanodeConnection(ofParameter<vector<_Tsource>>& pSource, ofParameter<vector<_Tsink>>& pSink) : ofxOceanodeAbstractConnection(pSource, pSink), sourceParameter(pSource), sinkParameter(pSink){
         beforeConnectionValue = sinkParameter.get();
         parameterEventListener = sourceParameter.newListener([&](vector<_Tsource> &vf){
-            //            sinkParameter = vector<_Tsink>(1, f);
-            vector<_Tsink> vec(vf.size());
-            for(int i = 0; i < vf.size(); i ++){
-                vec[i] = vf[i];
-            }
-            sinkParameter = vec;
+            pending = true;
         });
         //sinkParameter = vector<T>(1, sourceParameter);
     }
@@ -134,11 +186,21 @@ public:
         ofNotifyEvent(destroyConnection);
     };
     
+    void propagate() override{
+        if(!pending) return;
+        pending = false;
+        const vector<_Tsource> &vf = sourceParameter.get();
+        buffer.resize(vf.size());
+        ofxOceanodeConvertBuffer(vf.data(), buffer.data(), vf.size());
+        sinkParameter = buffer;
+    }
+    
 private:
     ofEventListener parameterEventListener;
     ofParameter<vector<_Tsource>>& sourceParameter;
     ofParameter<vector<_Tsink>>&  sinkParameter;
     vector<_Tsink> beforeConnectionValue;
+    vector<_Tsink> buffer;
 };
 
 template<typename>
@@ -148,12 +210,12 @@ template<typename T, typename A>
 struct is_std_vector<std::vector<T,A>> : std::true_type {};
 
 template<typename _Tsource, typename _Tsink>
-class ofxOceanodeConnection<_Tsource, vector<_Tsink>, typename std::enable_if<!is_std_vector<_Tsource>::value>::type>: public ofxOceanodeAbstractConnection{
+class ofxOceanodeConnection<_Tsource, vector<_Tsink>, typename std::enable_if<!is_std_vector<_Tsource>::value && !std::is_same<_Tsource, ofxOceanodeBuffer>::value>::type>: public ofxOceanodeAbstractConnection{
 public:
     ofxOceanodeConnection(ofParameter<_Tsource>& pSource, ofParameter<vector<_Tsink>>& pSink) : ofxOceanodeAbstractConnection(pSource, pSink), sourceParameter(pSource), sinkParameter(pSink){
         beforeConnectionValue = sinkParameter.get();
         parameterEventListener = sourceParameter.newListener([&](_Tsource &f){
-            sinkParameter = vector<_Tsink>(1, f);
+            pending = true;
         });
         //sinkParameter = vector<T>(1, sourceParameter);
     }
@@ -162,22 +224,28 @@ public:
         ofNotifyEvent(destroyConnection);
     };
     
+    void propagate() override{
+        if(!pending) return;
+        pending = false;
+        buffer.assign(1, sourceParameter.get());
+        sinkParameter = buffer;
+    }
+    
 private:
     ofEventListener parameterEventListener;
     ofParameter<_Tsource>& sourceParameter;
     ofParameter<vector<_Tsink>>&  sinkParameter;
     vector<_Tsink> beforeConnectionValue;
+    vector<_Tsink> buffer;
 };
 
 template<typename _Tsource, typename _Tsink>
-class ofxOceanodeConnection<vector<_Tsource>, _Tsink, typename std::enable_if<!is_std_vector<_Tsink>::value>::type>: public ofxOceanodeAbstractConnection{
+class ofxOceanodeConnection<vector<_Tsource>, _Tsink, typename std::enable_if<!is_std_vector<_Tsink>::value && !std::is_same<_Tsink, ofxOceanodeBuffer>::value>::type>: public ofxOceanodeAbstractConnection{
 public:
     ofxOceanodeConnection(ofParameter<vector<_Tsource>>& pSource, ofParameter<_Tsink>& pSink) : ofxOceanodeAbstractConnection(pSource, pSink), sourceParameter(pSource), sinkParameter(pSink){
         beforeConnectionValue = sinkParameter.get();
         parameterEventListener = sourceParameter.newListener([&](vector<_Tsource> &vf){
-            if(vf.size() > 0){
-                sinkParameter = vf[0];
-            }
+            pending = true;
         });
 //        if(sourceParameter.get().size() > 0){
 //            sinkParameter = sourceParameter.get()[0];
@@ -188,6 +256,14 @@ public:
         ofNotifyEvent(destroyConnection);
     };
     
+    void propagate() override{
+        if(!pending) return;
+        pending = false;
+        if(sourceParameter.get().size() > 0){
+            sinkParameter = sourceParameter.get()[0];
+        }
+    }
+    
 private:
     ofEventListener parameterEventListener;
     ofParameter<vector<_Tsource>>& sourceParameter;
@@ -196,6 +272,127 @@ private:
 };
 
 
+//Vectors to buffers, the values are copied once into a buffer the sink holds
+template<typename _Tsource>
+class ofxOceanodeConnection<vector<_Tsource>, ofxOceanodeBuffer>: public ofxOceanodeAbstractConnection{
+public:
+    ofxOceanodeConnection(ofParameter<vector<_Tsource>>& pSource, ofParameter<ofxOceanodeBuffer>& pSink) : ofxOceanodeAbstractConnection(pSource, pSink), sourceParameter(pSource), sinkParameter(pSink){
+        beforeConnectionValue = sinkParameter.get();
+        parameterEventListener = sourceParameter.newListener([&](vector<_Tsource> &vf){
+            pending = true;
+        });
+    }
+    ~ofxOceanodeConnection(){
+        sinkParameter.set(beforeConnectionValue);
+        ofNotifyEvent(destroyConnection);
+    };
+    
+    void propagate() override{
+        if(!pending) return;
+        pending = false;
+        const vector<_Tsource> &vf = sourceParameter.get();
+        ofxOceanodeConvertBuffer(vf.data(), writer.resize(vf.size()).data(), vf.size());
+        writer.publish(sinkParameter);
+    }
+    
+private:
+    ofEventListener parameterEventListener;
+    ofParameter<vector<_Tsource>>& sourceParameter;
+    ofParameter<ofxOceanodeBuffer>&  sinkParameter;
+    ofxOceanodeBuffer beforeConnectionValue;
+    ofxOceanodeBufferWriter writer;
+};
+
+//Buffers to vectors, for the nodes that take vectors
+template<typename _Tsink>
+class ofxOceanodeConnection<ofxOceanodeBuffer, vector<_Tsink>>: public ofxOceanodeAbstractConnection{
+public:
+    ofxOceanodeConnection(ofParameter<ofxOceanodeBuffer>& pSource, ofParameter<vector<_Tsink>>& pSink) : ofxOceanodeAbstractConnection(pSource, pSink), sourceParameter(pSource), sinkParameter(pSink){
+        beforeConnectionValue = sinkParameter.get();
+        parameterEventListener = sourceParameter.newListener([&](ofxOceanodeBuffer &b){
+            pending = true;
+        });
+    }
+    ~ofxOceanodeConnection(){
+        sinkParameter.set(beforeConnectionValue);
+        ofNotifyEvent(destroyConnection);
+    };
+    
+    void propagate() override{
+        if(!pending) return;
+        pending = false;
+        const ofxOceanodeBuffer &b = sourceParameter.get();
+        buffer.resize(b.size());
+        ofxOceanodeConvertBuffer(b.data(), buffer.data(), b.size());
+        sinkParameter = buffer;
+    }
+    
+private:
+    ofEventListener parameterEventListener;
+    ofParameter<ofxOceanodeBuffer>& sourceParameter;
+    ofParameter<vector<_Tsink>>&  sinkParameter;
+    vector<_Tsink> beforeConnectionValue;
+    vector<_Tsink> buffer;
+};
+
+template<typename _Tsource>
+class ofxOceanodeConnection<_Tsource, ofxOceanodeBuffer, typename std::enable_if<!is_std_vector<_Tsource>::value && !std::is_same<_Tsource, ofxOceanodeBuffer>::value>::type>: public ofxOceanodeAbstractConnection{
+public:
+    ofxOceanodeConnection(ofParameter<_Tsource>& pSource, ofParameter<ofxOceanodeBuffer>& pSink) : ofxOceanodeAbstractConnection(pSource, pSink), sourceParameter(pSource), sinkParameter(pSink){
+        beforeConnectionValue = sinkParameter.get();
+        parameterEventListener = sourceParameter.newListener([&](_Tsource &f){
+            pending = true;
+        });
+    }
+    ~ofxOceanodeConnection(){
+        sinkParameter.set(beforeConnectionValue);
+        ofNotifyEvent(destroyConnection);
+    };
+    
+    void propagate() override{
+        if(!pending) return;
+        pending = false;
+        writer.resize(1)[0] = sourceParameter.get();
+        writer.publish(sinkParameter);
+    }
+    
+private:
+    ofEventListener parameterEventListener;
+    ofParameter<_Tsource>& sourceParameter;
+    ofParameter<ofxOceanodeBuffer>&  sinkParameter;
+    ofxOceanodeBuffer beforeConnectionValue;
+    ofxOceanodeBufferWriter writer;
+};
+
+template<typename _Tsink>
+class ofxOceanodeConnection<ofxOceanodeBuffer, _Tsink, typename std::enable_if<!is_std_vector<_Tsink>::value && !std::is_same<_Tsink, ofxOceanodeBuffer>::value>::type>: public ofxOceanodeAbstractConnection{
+public:
+    ofxOceanodeConnection(ofParameter<ofxOceanodeBuffer>& pSource, ofParameter<_Tsink>& pSink) : ofxOceanodeAbstractConnection(pSource, pSink), sourceParameter(pSource), sinkParameter(pSink){
+        beforeConnectionValue = sinkParameter.get();
+        parameterEventListener = sourceParameter.newListener([&](ofxOceanodeBuffer &b){
+            pending = true;
+        });
+    }
+    ~ofxOceanodeConnection(){
+        sinkParameter.set(beforeConnectionValue);
+        ofNotifyEvent(destroyConnection);
+    };
+    
+    void propagate() override{
+        if(!pending) return;
+        pending = false;
+        if(sourceParameter.get().size() > 0){
+            sinkParameter = sourceParameter.get()[0];
+        }
+    }
+    
+private:
+    ofEventListener parameterEventListener;
+    ofParameter<ofxOceanodeBuffer>& sourceParameter;
+    ofParameter<_Tsink>&  sinkParameter;
+    _Tsink beforeConnectionValue;
+};
+
 template<typename T>
 class ofxOceanodeConnection<void, T>: public ofxOceanodeAbstractConnection{
 public:
@@ -207,6 +404,7 @@ public:
     };
     
 private:
+    //Triggers are events, not values, they are forwarded right away
     void linkParameters(){
         parameterEventListener = sourceParameter.newListener([&](){
             sinkParameter = sinkParameter;
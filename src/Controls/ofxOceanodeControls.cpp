@@ -43,6 +43,7 @@ ofxOceanodeControls::ofxOceanodeControls(shared_ptr<ofxOceanodeContainer> _conta
     listeners.push(controlsWindow->events().mouseReleased.newListener(this, &ofxOceanodeControls::mouseReleased));
     listeners.push(controlsWindow->events().mouseDragged.newListener(this, &ofxOceanodeControls::mouseDragged));
     listeners.push(controlsWindow->events().windowResized.newListener(this, &ofxOceanodeControls::windowResized));
+    container->registerGuiWindow(controlsWindow);
 //    ofAppGLFWWindow * ofWindow = (ofAppGLFWWindow*)controlsWindow.get();
 //    GLFWwindow * glfwWindow = ofWindow->getGLFWWindow();
     //        glfwSetWindowCloseCallback(glfwWindow, window_no_close_indexer);
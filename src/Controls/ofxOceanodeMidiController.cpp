@@ -79,6 +79,11 @@ void ofxOceanodeMidiController::newParameterBinding(ofxOceanodeAbstractMidiBindi
         folder->addSlider(midiBindingCasted.getMinParameter())->setPrecision(1000);
         folder->addSlider(midiBindingCasted.getMaxParameter())->setPrecision(1000);
     }
+    else if(binding.type() == typeid(ofxOceanodeMidiBinding<ofxOceanodeBuffer>).name()){
+        auto &midiBindingCasted = static_cast<ofxOceanodeMidiBinding<ofxOceanodeBuffer> &>(binding);
+        folder->addSlider(midiBindingCasted.getMinParameter())->setPrecision(1000);
+        folder->addSlider(midiBindingCasted.getMaxParameter())->setPrecision(1000);
+    }
     else if(binding.type() == typeid(ofxOceanodeMidiBinding<vector<int>>).name()){
         auto &midiBindingCasted = static_cast<ofxOceanodeMidiBinding<vector<int>> &>(binding);
         folder->addSlider(midiBindingCasted.getMinParameter())->setPrecision(1000);
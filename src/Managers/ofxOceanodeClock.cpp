@@ -0,0 +1,88 @@
+//
+//  ofxOceanodeClock.cpp
+//  ofxOceanode
+//
+
+#include "ofxOceanodeClock.h"
+#include "basePhasor.h"
+
+ofxOceanodeClock::ofxOceanodeClock(float _rate){
+    rate = ofClamp(_rate, 1, 10000);
+    timerRate = rate;
+    timer.setPeriodicEvent(uint64_t(1000000000.0 / timerRate));
+    transportOut.store(transport{now(), 0, 120, true, 0});
+    startThread();
+}
+
+ofxOceanodeClock::~ofxOceanodeClock(){
+    stopThread();
+    waitForThread(true);
+}
+
+shared_ptr<ofxOceanodeClock> ofxOceanodeClock::getShared(){
+    static std::mutex sharedMutex;
+    static weak_ptr<ofxOceanodeClock> shared;
+    std::lock_guard<std::mutex> lock(sharedMutex);
+    auto clock = shared.lock();
+    if(clock == nullptr){
+        clock = make_shared<ofxOceanodeClock>();
+        shared = clock;
+    }
+    return clock;
+}
+
+void ofxOceanodeClock::addPhasor(basePhasor *phasor){
+    std::lock_guard<std::recursive_mutex> lock(phasorsMutex);
+    phasors.push_back(phasor);
+}
+
+void ofxOceanodeClock::removePhasor(basePhasor *phasor){
+    //Once removed the clock thread doesn't touch it anymore, it can be safely destroyed
+    std::lock_guard<std::recursive_mutex> lock(phasorsMutex);
+    phasors.erase(std::remove(phasors.begin(), phasors.end(), phasor), phasors.end());
+}
+
+void ofxOceanodeClock::setRate(float _rate){
+    rate = ofClamp(_rate, 1, 10000);
+}
+
+void ofxOceanodeClock::setBpm(double bpm, double time){
+    std::lock_guard<std::mutex> lock(transportMutex);
+    transport t = transportOut.load();
+    if(t.bpm == bpm) return;
+    transportOut.store(transport{time, getBeat(t, time), bpm, t.running, t.restarts});
+}
+
+void ofxOceanodeClock::resetBeat(double time){
+    std::lock_guard<std::mutex> lock(transportMutex);
+    transport t = transportOut.load();
+    transportOut.store(transport{time, 0, t.bpm, t.running, t.restarts + 1});
+}
+
+void ofxOceanodeClock::setBeat(double beat, bool running, double time){
+    std::lock_guard<std::mutex> lock(transportMutex);
+    transport t = transportOut.load();
+    transportOut.store(transport{time, beat, t.bpm, running, t.restarts});
+}
+
+double ofxOceanodeClock::now(){
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void ofxOceanodeClock::threadedFunction(){
+    while(isThreadRunning()){
+        if(timerRate != rate){
+            timerRate = rate;
+            timer.setPeriodicEvent(uint64_t(1000000000.0 / timerRate));
+        }
+        timer.waitNext();
+        
+        //Every phasor is evaluated at the same time of the timebase, taken with the lock so changes
+        //made while the phasors were locked are always before it
+        std::lock_guard<std::recursive_mutex> lock(phasorsMutex);
+        double time = now();
+        for(auto phasor : phasors){
+            phasor->advance(time);
+        }
+    }
+}
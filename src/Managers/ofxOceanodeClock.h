@@ -0,0 +1,67 @@
+//
+//  ofxOceanodeClock.h
+//  ofxOceanode
+//
+
+#ifndef ofxOceanodeClock_h
+#define ofxOceanodeClock_h
+
+#include "ofMain.h"
+#include "ofxOceanodeSeqLock.h"
+
+class basePhasor;
+
+//Single thread that advances every phasor from a shared timebase, instead of one thread and timer per phasor.
+//Each container owns a clock for the phasors of its nodes, phasors used outside a container run on the
+//process wide clock returned by getShared().
+class ofxOceanodeClock : public ofThread{
+public:
+    ofxOceanodeClock(float _rate = 1000);
+    ~ofxOceanodeClock();
+    
+    static shared_ptr<ofxOceanodeClock> getShared();
+    
+    void addPhasor(basePhasor *phasor);
+    void removePhasor(basePhasor *phasor);
+    //No phasor advances while it is held, changes made meanwhile are seen by all of them on the same wake
+    std::unique_lock<std::recursive_mutex> lockPhasors(){return std::unique_lock<std::recursive_mutex>(phasorsMutex);};
+    
+    void setRate(float _rate);
+    float getRate(){return rate;};
+    
+    //Beat timeline shared by the phasors of the clock, it starts at beat 0 when the clock is created.
+    //Phasors at its bpm compute their phase from it, so they stay locked whatever their wakes are.
+    struct transport{
+        double time; //Anchor in seconds of the timebase
+        double beat; //Beats at the anchor time
+        double bpm;
+        bool running; //Stopped the beat stays at the anchor
+        uint32_t restarts; //Incremented every time the beat is reset to 0
+    };
+    transport getTransport(){return transportOut.load();};
+    static double getBeat(const transport &t, double time){return t.beat + (t.running ? (time - t.time) * t.bpm / 60.0 : 0);};
+    //Tempo changes are anchored at the time they are made and keep the beat continuous
+    void setBpm(double bpm, double time = now());
+    //Beat 0 at time, phasors reset together with it restart exactly at that time
+    void resetBeat(double time = now());
+    //Beat position given by an external transport (the midi clock), it advances from time at the clock bpm
+    void setBeat(double beat, bool running, double time = now());
+    
+    //Seconds of the shared timebase (monotonic)
+    static double now();
+    
+private:
+    void threadedFunction() override;
+    
+    std::mutex transportMutex; //Serializes the writers, phasors read without locking
+    ofxOceanodeSeqLock<transport> transportOut;
+    
+    ofTimer timer;
+    std::atomic<float> rate;
+    float timerRate;
+    
+    std::recursive_mutex phasorsMutex;
+    vector<basePhasor*> phasors;
+};
+
+#endif /* ofxOceanodeClock_h */
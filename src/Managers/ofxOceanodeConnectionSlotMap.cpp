@@ -0,0 +1,56 @@
+//
+//  ofxOceanodeConnectionSlotMap.cpp
+//  ofxOceanode
+//
+
+#include "ofxOceanodeConnectionSlotMap.h"
+
+ofxOceanodeConnectionHandle ofxOceanodeConnectionSlotMap::insert(shared_ptr<ofxOceanodeAbstractConnection> connection){
+    uint32_t slotIndex;
+    if(freeSlots.empty()){
+        slotIndex = slots.size();
+        slots.emplace_back();
+    }else{
+        slotIndex = freeSlots.back();
+        freeSlots.pop_back();
+    }
+    auto &s = slots[slotIndex];
+    s.used = true;
+    s.packedIndex = connections.size();
+    connections.push_back(connection);
+    packedToSlot.push_back(slotIndex);
+
+    ofxOceanodeConnectionHandle handle;
+    handle.index = slotIndex;
+    handle.generation = s.generation;
+    connection->setHandle(handle);
+    return handle;
+}
+
+shared_ptr<ofxOceanodeAbstractConnection> ofxOceanodeConnectionSlotMap::erase(ofxOceanodeConnectionHandle handle){
+    if(!contains(handle)) return nullptr;
+    auto &s = slots[handle.index];
+    uint32_t packedIndex = s.packedIndex;
+    auto erased = std::move(connections[packedIndex]);
+
+    //Move the last connection to the hole
+    connections[packedIndex] = std::move(connections.back());
+    packedToSlot[packedIndex] = packedToSlot.back();
+    slots[packedToSlot[packedIndex]].packedIndex = packedIndex;
+    connections.pop_back();
+    packedToSlot.pop_back();
+
+    s.used = false;
+    s.generation++;
+    freeSlots.push_back(handle.index);
+
+    erased->setHandle(ofxOceanodeConnectionHandle());
+    return erased;
+}
+
+ofxOceanodeAbstractConnection* ofxOceanodeConnectionSlotMap::get(ofxOceanodeConnectionHandle handle){
+    if(handle.index >= slots.size()) return nullptr;
+    auto &s = slots[handle.index];
+    if(!s.used || s.generation != handle.generation) return nullptr;
+    return connections[s.packedIndex].get();
+}
@@ -0,0 +1,39 @@
+//
+//  ofxOceanodeConnectionSlotMap.h
+//  ofxOceanode
+//
+
+#ifndef ofxOceanodeConnectionSlotMap_h
+#define ofxOceanodeConnectionSlotMap_h
+
+#include "ofxOceanodeConnection.h"
+
+//Storage of the container connections. Insert, erase and lookup by handle are O(1),
+//the connections are kept packed so iterating them is a plain vector loop (order is not preserved on erase).
+class ofxOceanodeConnectionSlotMap{
+public:
+    ofxOceanodeConnectionHandle insert(shared_ptr<ofxOceanodeAbstractConnection> connection);
+    //Returns the erased connection so the caller decides when it is destroyed, nullptr if the handle is stale
+    shared_ptr<ofxOceanodeAbstractConnection> erase(ofxOceanodeConnectionHandle handle);
+    ofxOceanodeAbstractConnection* get(ofxOceanodeConnectionHandle handle);
+    bool contains(ofxOceanodeConnectionHandle handle){return get(handle) != nullptr;};
+
+    size_t size(){return connections.size();};
+    shared_ptr<ofxOceanodeAbstractConnection>& operator[](size_t i){return connections[i];};
+    vector<shared_ptr<ofxOceanodeAbstractConnection>>::iterator begin(){return connections.begin();};
+    vector<shared_ptr<ofxOceanodeAbstractConnection>>::iterator end(){return connections.end();};
+
+private:
+    struct slot{
+        uint32_t generation = 0;
+        uint32_t packedIndex = 0;
+        bool used = false;
+    };
+
+    vector<slot> slots;
+    vector<uint32_t> freeSlots;
+    vector<shared_ptr<ofxOceanodeAbstractConnection>> connections;
+    vector<uint32_t> packedToSlot;
+};
+
+#endif /* ofxOceanodeConnectionSlotMap_h */
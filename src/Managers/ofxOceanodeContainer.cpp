@@ -11,31 +11,72 @@
 #include "ofxOceanodeNodeRegistry.h"
 #include "ofxOceanodeTypesRegistry.h"
 #include "ofxOceanodeNodeModel.h"
+#include "ofxOceanodeEngine.h"
+#include "ofxOceanodeThreadPool.h"
+#include "ofxOceanodeClock.h"
 
 #ifdef OFXOCEANODE_USE_MIDI
 #include "ofxOceanodeMidiBinding.h"
 #include "ofxMidiIn.h"
 #include "ofxMidiOut.h"
+
+#include "ofxOceanodeSPSCQueue.h"
+
+//Queues the messages of one port on the midi thread with their arrival time, the engine tick dispatches them
+class ofxOceanodeMidiPortListener : public ofxMidiListener{
+public:
+    struct timedMessage{
+        ofxMidiMessage message;
+        std::chrono::steady_clock::time_point timestamp;
+    };
+    
+    ofxOceanodeMidiPortListener() : queue(1024){
+        droppedMessages = 0;
+    };
+    
+    void newMidiMessage(ofxMidiMessage& message){
+        if(!queue.push(timedMessage{message, std::chrono::steady_clock::now()})){
+            droppedMessages++;
+        }
+    };
+    
+    timedMessage* front(){return queue.front();};
+    bool popMessage(timedMessage &m){return queue.pop(m);};
+    //Messages lost because the queue was full
+    uint64_t getDroppedMessages(){return droppedMessages;};
+    
+private:
+    ofxOceanodeSPSCQueue<timedMessage> queue;
+    std::atomic<uint64_t> droppedMessages;
+};
 #endif
 
 
-ofxOceanodeContainer::ofxOceanodeContainer(shared_ptr<ofxOceanodeNodeRegistry> _registry, shared_ptr<ofxOceanodeTypesRegistry> _typesRegistry, bool _isHeadless) : registry(_registry), typesRegistry(_typesRegistry), isHeadless(_isHeadless){
+ofxOceanodeContainer::ofxOceanodeContainer(shared_ptr<ofxOceanodeNodeRegistry> _registry, shared_ptr<ofxOceanodeTypesRegistry> _typesRegistry, bool _isHeadless) : registry(_registry), typesRegistry(_typesRegistry), isHeadless(_isHeadless), guiLock(engineMutex, std::defer_lock){
     window = ofGetCurrentWindow();
     transformationMatrix = glm::mat4(1);
     temporalConnection = nullptr;
     bpm = 120;
     collapseAll = false;
+    engineRate = 1000;
+    scheduleDirty = true;
+    nodesVersion = 1;
+    engineThreads = 1;
+    engineDeterministic = false;
+    parallelTickRunning = false;
+    tickArgs = nullptr;
+    clock = make_shared<ofxOceanodeClock>();
     
-#ifdef OFXOCEANODE_USE_OSC
     updateListener = window->events().update.newListener(this, &ofxOceanodeContainer::update);
-#endif
+    registerGuiWindow(window);
     
 #ifdef OFXOCEANODE_USE_MIDI
     ofxMidiIn* midiIn = new ofxMidiIn();
     midiInPortList = midiIn->getInPortList();
     delete midiIn;
-    for(auto port : midiInPortList){
-        midiIns[port].openPort(port);
+    midiDispatchDirty = true;
+    for(int i = 0; i < midiInPortList.size(); i++){
+        openMidiInPort(midiInPortList[i]);
     }
     
     
@@ -46,10 +87,22 @@ ofxOceanodeContainer::ofxOceanodeContainer(shared_ptr<ofxOceanodeNodeRegistry> _
         midiOuts[port].openPort(port);
     }
     isListeningMidi = false;
+    //Values queued by a binding are not sent once it is destroyed
+    midiSenderListeners.push(midiBindingDestroyed.newListener([this](ofxOceanodeAbstractMidiBinding &binding){
+        dropMidiOutputs(&binding);
+    }));
 #endif
 }
 
 ofxOceanodeContainer::~ofxOceanodeContainer(){
+    unlockGui();
+#ifdef OFXOCEANODE_USE_MIDI
+    for(int i = 0; i < midiPortListeners.size(); i++){
+        midiIns[midiInPortList[i]].removeListener(midiPortListeners[i].get());
+    }
+#endif
+    engine.reset();
+    threadPool.reset();
     dynamicNodes.clear();
     persistentNodes.clear();
 }
@@ -67,25 +120,49 @@ ofxOceanodeAbstractConnection* ofxOceanodeContainer::createConnection(ofAbstract
 }
 
 ofxOceanodeAbstractConnection* ofxOceanodeContainer::disconnectConnection(ofxOceanodeAbstractConnection* connection){
-    for(auto c : connections){
-        if(c.second.get() == connection){
-            if(!ofGetKeyPressed(OF_KEY_ALT)){
-                connections.erase(std::remove(connections.begin(), connections.end(), c));
-            }
-            return createConnection(connection->getSourceParameter(), *c.first);
-            break;
-        }
+    if(!connections.contains(connection->getHandle())) return nullptr;
+    ofxOceanodeNode* sourceNode = connection->getSourceNode();
+    ofAbstractParameter& sourceParameter = connection->getSourceParameter();
+    if(!ofGetKeyPressed(OF_KEY_ALT)){
+        connections.erase(connection->getHandle());
+        scheduleDirty = true;
     }
-    return nullptr;
+    return createConnection(sourceParameter, *sourceNode);
 }
 
 void ofxOceanodeContainer::destroyConnection(ofxOceanodeAbstractConnection* connection){
-    for(auto c : connections){
-        if(c.second.get() == connection){
-            connections.erase(std::remove(connections.begin(), connections.end(), c));
-            break;
+    if(connections.erase(connection->getHandle()) != nullptr){
+        scheduleDirty = true;
+    }
+}
+
+void ofxOceanodeContainer::destroyConnections(const vector<ofxOceanodeAbstractConnection*> &connectionsToBeDeleted){
+    //Take all the handles first, a connection can be twice in the list (node connected to itself)
+    vector<ofxOceanodeConnectionHandle> handles;
+    handles.reserve(connectionsToBeDeleted.size());
+    for(auto c : connectionsToBeDeleted){
+        handles.push_back(c->getHandle());
+    }
+    //Stale handles are ignored, the connections can be gone when a deferred change runs
+    if(deferGraphChange([this, handles](){
+        for(auto &handle : handles){
+            connections.erase(handle);
         }
+        scheduleDirty = true;
+    })) return;
+    for(auto &handle : handles){
+        connections.erase(handle);
     }
+    scheduleDirty = true;
+}
+
+void ofxOceanodeContainer::destroyNonPersistentConnections(){
+    for(int i = connections.size() - 1; i >= 0; i--){
+        if(!connections[i]->getIsPersistent()){
+            connections.erase(connections[i]->getHandle());
+        }
+    }
+    scheduleDirty = true;
 }
 
 ofxOceanodeNode* ofxOceanodeContainer::createNodeFromName(string name, int identifier, bool isPersistent){
@@ -107,12 +184,12 @@ ofxOceanodeNode& ofxOceanodeContainer::createNode(unique_ptr<ofxOceanodeNodeMode
     int toBeCreatedId = identifier;
     string nodeToBeCreatedName = nodeModel->nodeName();
     if(identifier == -1){
-        int lastId = 1;
-        while (dynamicNodes[nodeToBeCreatedName].count(lastId) != 0 || persistentNodes[nodeToBeCreatedName].count(lastId) != 0) lastId++;
-        toBeCreatedId = lastId;
+        toBeCreatedId = nodeIds[nodeToBeCreatedName].allocate();
+    }else{
+        nodeIds[nodeToBeCreatedName].reserve(identifier);
     }
     nodeModel->setNumIdentifier(toBeCreatedId);
-    nodeModel->registerLoop(window);
+    nodeModel->registerLoop(window, [this](){return lockEngine();});
     auto node = make_unique<ofxOceanodeNode>(move(nodeModel));
     node->setup();
     if(!isHeadless){
@@ -123,39 +200,38 @@ ofxOceanodeNode& ofxOceanodeContainer::createNode(unique_ptr<ofxOceanodeNodeMode
 #endif
         node->setGui(std::move(nodeGui));
     }
+    node->setClock(clock);
     node->setBpm(bpm);
     node->setPhase(phase);
     node->setIsPersistent(isPersistent);
     
     auto nodePtr = node.get();
     collection[nodeToBeCreatedName][toBeCreatedId] = std::move(node);
+    scheduleDirty = true;
+    nodesVersion++;
+    destroyNodeListeners.push(nodePtr->getNodeModel().parameterGroupChanged.newListener([this](){
+        nodesVersion++;
+    }));
     
     if(!isPersistent){
-        destroyNodeListeners.push(nodePtr->deleteModuleAndConnections.newListener([this, nodeToBeCreatedName, toBeCreatedId](vector<ofxOceanodeAbstractConnection*> connectionsToBeDeleted){
-            for(auto containerConnectionIterator = connections.begin(); containerConnectionIterator!=connections.end();){
-                bool foundConnection = false;
-                for(auto nodeConnection : connectionsToBeDeleted){
-                    if(containerConnectionIterator->second.get() == nodeConnection){
-                        foundConnection = true;
-                        connections.erase(containerConnectionIterator);
-                        connectionsToBeDeleted.erase(std::remove(connectionsToBeDeleted.begin(), connectionsToBeDeleted.end(), nodeConnection));
-                        break;
-                    }
-                }
-                if(!foundConnection){
-                    containerConnectionIterator++;
+        destroyNodeListeners.push(nodePtr->deleteModuleAndConnections.newListener([this, nodeToBeCreatedName, toBeCreatedId, nodePtr](vector<ofxOceanodeAbstractConnection*> connectionsToBeDeleted){
+            bool deferred = deferGraphChange([this, nodeToBeCreatedName, toBeCreatedId, nodePtr, connectionsToBeDeleted]() mutable{
+                auto &nodes = dynamicNodes[nodeToBeCreatedName];
+                if(nodes.count(toBeCreatedId) == 1 && nodes[toBeCreatedId].get() == nodePtr){
+                    nodePtr->deleteModuleAndConnections.notify(connectionsToBeDeleted);
                 }
-            }
+            });
+            if(deferred) return;
+            
+            destroyConnections(connectionsToBeDeleted);
             
 #ifdef OFXOCEANODE_USE_MIDI
             string toBeCreatedEscaped = nodeToBeCreatedName + " " + ofToString(toBeCreatedId);
             ofStringReplace(toBeCreatedEscaped, " ", "_");
             vector<string> midiBindingToBeRemoved;
+            std::lock_guard<std::recursive_mutex> midiLock(midiDispatchMutex);
             for(auto &midiBind : midiBindings){
                 if(ofSplitString(midiBind.first, "-|-")[0] == toBeCreatedEscaped){
-                    for(auto &midiInPair : midiIns){
-                        midiInPair.second.removeListener(midiBind.second.get());
-                    }
                     midiBindingDestroyed.notify(this, *midiBind.second.get());
                     midiBindingToBeRemoved.push_back(midiBind.first);
                 }
@@ -163,26 +239,17 @@ ofxOceanodeNode& ofxOceanodeContainer::createNode(unique_ptr<ofxOceanodeNodeMode
             for(auto &s : midiBindingToBeRemoved){
                 midiBindings.erase(s);
             }
+            midiDispatchDirty = true;
 #endif
             
             dynamicNodes[nodeToBeCreatedName].erase(toBeCreatedId);
+            nodeIds[nodeToBeCreatedName].release(toBeCreatedId);
+            scheduleDirty = true;
+            nodesVersion++;
         }));
         
         destroyNodeListeners.push(nodePtr->deleteConnections.newListener([this](vector<ofxOceanodeAbstractConnection*> connectionsToBeDeleted){
-            for(auto containerConnectionIterator = connections.begin(); containerConnectionIterator!=connections.end();){
-                bool foundConnection = false;
-                for(auto nodeConnection : connectionsToBeDeleted){
-                    if(containerConnectionIterator->second.get() == nodeConnection){
-                        foundConnection = true;
-                        connections.erase(containerConnectionIterator);
-                        connectionsToBeDeleted.erase(std::remove(connectionsToBeDeleted.begin(), connectionsToBeDeleted.end(), nodeConnection));
-                        break;
-                    }
-                }
-                if(!foundConnection){
-                    containerConnectionIterator++;
-                }
-            }
+            destroyConnections(connectionsToBeDeleted);
         }));
         
         duplicateNodeListeners.push(nodePtr->duplicateModule.newListener([this, nodeToBeCreatedName, nodePtr](glm::vec2 pos){
@@ -197,12 +264,44 @@ ofxOceanodeNode& ofxOceanodeContainer::createNode(unique_ptr<ofxOceanodeNodeMode
     return *nodePtr;
 }
 
+int ofxOceanodeContainer::nodeIdAllocator::allocate(){
+    if(!freeIds.empty()){
+        int id = *freeIds.begin();
+        freeIds.erase(freeIds.begin());
+        return id;
+    }
+    return nextId++;
+}
+
+void ofxOceanodeContainer::nodeIdAllocator::reserve(int id){
+    if(id < 1) return;
+    if(id < nextId){
+        freeIds.erase(id);
+    }else{
+        for(int i = nextId; i < id; i++){
+            freeIds.insert(i);
+        }
+        nextId = id + 1;
+    }
+}
+
+void ofxOceanodeContainer::nodeIdAllocator::release(int id){
+    if(id < 1 || id >= nextId) return;
+    freeIds.insert(id);
+    //Keep the free set small, give back the tail to the counter
+    while(!freeIds.empty() && *freeIds.rbegin() == nextId - 1){
+        freeIds.erase(std::prev(freeIds.end()));
+        nextId--;
+    }
+}
+
 void ofxOceanodeContainer::temporalConnectionDestructor(){
     delete temporalConnection;
     temporalConnection = nullptr;
 }
 
 bool ofxOceanodeContainer::loadPreset(string presetFolderPath){
+    if(deferGraphChange([this, presetFolderPath](){loadPreset(presetFolderPath);})) return true;
     ofStringReplace(presetFolderPath, " ", "_");
     ofLog()<<"Load Preset " << presetFolderPath;
     
@@ -221,13 +320,7 @@ bool ofxOceanodeContainer::loadPreset(string presetFolderPath){
         }
     }
     
-    for(int i = 0; i < connections.size();){
-        if(!connections[i].second->getIsPersistent()){
-            connections.erase(connections.begin()+i);
-        }else{
-            i++;
-        }
-    }
+    destroyNonPersistentConnections();
     
     //Read new nodes in preset
     //Check if the nodes exists and update them, (or update all at the end)
@@ -286,19 +379,27 @@ bool ofxOceanodeContainer::loadPreset(string presetFolderPath){
             }
         }
     }else{
+        for(auto &nodeTypeMap : dynamicNodes){
+            for(auto &node : nodeTypeMap.second){
+                nodeIds[nodeTypeMap.first].release(node.first);
+            }
+        }
         dynamicNodes.clear();
+        scheduleDirty = true;
+        nodesVersion++;
     }
     
     
 #ifdef OFXOCEANODE_USE_MIDI
     json.clear();
-    for(auto &binding : midiBindings){
-        for(auto &midiInPair : midiIns){
-            midiInPair.second.removeListener(binding.second.get());
+    {
+        std::lock_guard<std::recursive_mutex> midiLock(midiDispatchMutex);
+        for(auto &binding : midiBindings){
+            midiBindingDestroyed.notify(this, *binding.second.get());
         }
-        midiBindingDestroyed.notify(this, *binding.second.get());
+        midiBindings.clear();
+        midiDispatchDirty = true;
     }
-    midiBindings.clear();
     json = ofLoadJson(presetFolderPath + "/midi.json");
     for (ofJson::iterator module = json.begin(); module != json.end(); ++module) {
         for (ofJson::iterator parameter = module.value().begin(); parameter != module.value().end(); ++parameter) {
@@ -369,11 +470,11 @@ void ofxOceanodeContainer::savePreset(string presetFolderPath){
     
     json.clear();
     for(auto &connection : connections){
-        if(!connection.second->getIsPersistent()){
-            string sourceName = connection.second->getSourceParameter().getName();
-            string sourceParentName = connection.second->getSourceParameter().getGroupHierarchyNames()[0];
-            string sinkName = connection.second->getSinkParameter().getName();
-            string sinkParentName = connection.second->getSinkParameter().getGroupHierarchyNames()[0];
+        if(!connection->getIsPersistent()){
+            string sourceName = connection->getSourceParameter().getName();
+            string sourceParentName = connection->getSourceParameter().getGroupHierarchyNames()[0];
+            string sinkName = connection->getSinkParameter().getName();
+            string sinkParentName = connection->getSinkParameter().getGroupHierarchyNames()[0];
             json[sourceParentName][sourceName][sinkParentName][sinkName];
         }
     }
@@ -429,10 +530,10 @@ void ofxOceanodeContainer::savePersistent(){
     
     json.clear();
     for(auto &connection : connections){
-        string sourceName = connection.second->getSourceParameter().getName();
-        string sourceParentName = connection.second->getSourceParameter().getGroupHierarchyNames()[0];
-        string sinkName = connection.second->getSinkParameter().getName();
-        string sinkParentName = connection.second->getSinkParameter().getGroupHierarchyNames()[0];
+        string sourceName = connection->getSourceParameter().getName();
+        string sourceParentName = connection->getSourceParameter().getGroupHierarchyNames()[0];
+        string sinkName = connection->getSinkParameter().getName();
+        string sinkParentName = connection->getSinkParameter().getGroupHierarchyNames()[0];
         json[sourceParentName][sourceName][sinkParentName][sinkName];
     }
     
@@ -503,17 +604,18 @@ void ofxOceanodeContainer::loadPersistent(){
             }
         }
     }else{
+        for(auto &nodeTypeMap : persistentNodes){
+            for(auto &node : nodeTypeMap.second){
+                nodeIds[nodeTypeMap.first].release(node.first);
+            }
+        }
         persistentNodes.clear();
+        scheduleDirty = true;
+        nodesVersion++;
     }
     
     //connections.clear();
-    for(int i = 0; i < connections.size();){
-        if(!connections[i].second->getIsPersistent()){
-            connections.erase(connections.begin()+i);
-        }else{
-            i++;
-        }
-    }
+    destroyNonPersistentConnections();
     
     for(auto &nodeTypeMap : persistentNodes){
         for(auto &node : nodeTypeMap.second){
@@ -536,13 +638,14 @@ void ofxOceanodeContainer::loadPersistent(){
     
 #ifdef OFXOCEANODE_USE_MIDI
     json.clear();
-    for(auto &binding : persistentMidiBindings){
-        for(auto &midiInPair : midiIns){
-            midiInPair.second.removeListener(binding.second.get());
+    {
+        std::lock_guard<std::recursive_mutex> midiLock(midiDispatchMutex);
+        for(auto &binding : persistentMidiBindings){
+            midiBindingDestroyed.notify(this, *binding.second.get());
         }
-        midiBindingDestroyed.notify(this, *binding.second.get());
+        persistentMidiBindings.clear();
+        midiDispatchDirty = true;
     }
-    persistentMidiBindings.clear();
     json = ofLoadJson(persistentFolderPath + "/midi.json");
     for (ofJson::iterator module = json.begin(); module != json.end(); ++module) {
         for (ofJson::iterator parameter = module.value().begin(); parameter != module.value().end(); ++parameter) {
@@ -572,6 +675,9 @@ void ofxOceanodeContainer::updatePersistent(){
 
 void ofxOceanodeContainer::setBpm(float _bpm){
     bpm = _bpm;
+    //The tempo change is anchored once for all the phasors, they see it on the same clock wake
+    auto clockLock = clock->lockPhasors();
+    clock->setBpm(bpm);
     for(auto &nodeTypeMap : dynamicNodes){
         for(auto &node : nodeTypeMap.second){
             node.second->setBpm(bpm);
@@ -599,6 +705,13 @@ void ofxOceanodeContainer::setPhase(float _phase){
 }
 
 void ofxOceanodeContainer::resetPhase(){
+    resetPhaseAt(ofxOceanodeClock::now());
+}
+
+void ofxOceanodeContainer::resetPhaseAt(double time){
+    //Phasors at the container bpm restart exactly at the time the transport restarts
+    auto clockLock = clock->lockPhasors();
+    clock->resetBeat(time);
     for(auto &nodeTypeMap : dynamicNodes){
         for(auto &node : nodeTypeMap.second){
             node.second->resetPhase();
@@ -638,64 +751,493 @@ void ofxOceanodeContainer::expandGuis(){
     }
 }
 
+void ofxOceanodeContainer::setEngineThreaded(bool threaded, float rate){
+    engineRate = rate;
+    if(threaded && engine == nullptr){
+        engine = make_unique<ofxOceanodeEngine>(engineMutex, engineRate);
+        engineListener = engine->tickEvent.newListener(this, &ofxOceanodeContainer::tick);
+    }else if(!threaded && engine != nullptr){
+        engineListener.unsubscribe();
+        engine.reset();
+    }else if(engine != nullptr){
+        engine->setRate(engineRate);
+    }
+}
+
+void ofxOceanodeContainer::setEngineRate(float rate){
+    engineRate = rate;
+    if(engine != nullptr){
+        engine->setRate(engineRate);
+    }
+}
+
+void ofxOceanodeContainer::setEngineThreads(int threads){
+    auto lock = lockEngine();
+    engineThreads = max(threads, 1);
+    if(engineThreads == 1){
+        threadPool.reset();
+    }else if(threadPool == nullptr || threadPool->getNumThreads() != engineThreads){
+        threadPool = make_unique<ofxOceanodeThreadPool>(engineThreads);
+    }
+}
+
+void ofxOceanodeContainer::setEngineDeterministic(bool deterministic){
+    auto lock = lockEngine();
+    engineDeterministic = deterministic;
+}
+
+bool ofxOceanodeContainer::deferGraphChange(std::function<void()> change){
+    if(!parallelTickRunning) return false;
+    std::lock_guard<std::mutex> lock(deferredGraphChangesMutex);
+    deferredGraphChanges.push_back(change);
+    scheduleDirty = true;
+    return true;
+}
+
+void ofxOceanodeContainer::applyDeferredGraphChanges(){
+    vector<std::function<void()>> changes;
+    {
+        std::lock_guard<std::mutex> lock(deferredGraphChangesMutex);
+        std::swap(changes, deferredGraphChanges);
+    }
+    for(auto &change : changes){
+        change();
+    }
+}
+
+void ofxOceanodeContainer::setClockRate(float rate){
+    clock->setRate(rate);
+}
+
+float ofxOceanodeContainer::getClockRate(){
+    return clock->getRate();
+}
+
+void ofxOceanodeContainer::registerGuiWindow(shared_ptr<ofAppBaseWindow> w){
+    int lockOrder = OF_EVENT_ORDER_BEFORE_APP - 1;
+    int unlockOrder = OF_EVENT_ORDER_AFTER_APP + 1;
+    guiWindowListeners.push(w->events().update.newListener([this](ofEventArgs &){lockGui();}, lockOrder));
+    guiWindowListeners.push(w->events().update.newListener([this](ofEventArgs &){unlockGui();}, unlockOrder));
+    guiWindowListeners.push(w->events().mousePressed.newListener([this](ofMouseEventArgs &){lockGui();}, lockOrder));
+    guiWindowListeners.push(w->events().mousePressed.newListener([this](ofMouseEventArgs &){unlockGui();}, unlockOrder));
+    guiWindowListeners.push(w->events().mouseReleased.newListener([this](ofMouseEventArgs &){lockGui();}, lockOrder));
+    guiWindowListeners.push(w->events().mouseReleased.newListener([this](ofMouseEventArgs &){unlockGui();}, unlockOrder));
+    guiWindowListeners.push(w->events().mouseDragged.newListener([this](ofMouseEventArgs &){lockGui();}, lockOrder));
+    guiWindowListeners.push(w->events().mouseDragged.newListener([this](ofMouseEventArgs &){unlockGui();}, unlockOrder));
+    guiWindowListeners.push(w->events().mouseScrolled.newListener([this](ofMouseEventArgs &){lockGui();}, lockOrder));
+    guiWindowListeners.push(w->events().mouseScrolled.newListener([this](ofMouseEventArgs &){unlockGui();}, unlockOrder));
+    guiWindowListeners.push(w->events().keyPressed.newListener([this](ofKeyEventArgs &){lockGui();}, lockOrder));
+    guiWindowListeners.push(w->events().keyPressed.newListener([this](ofKeyEventArgs &){unlockGui();}, unlockOrder));
+    guiWindowListeners.push(w->events().keyReleased.newListener([this](ofKeyEventArgs &){lockGui();}, lockOrder));
+    guiWindowListeners.push(w->events().keyReleased.newListener([this](ofKeyEventArgs &){unlockGui();}, unlockOrder));
+}
+
+void ofxOceanodeContainer::lockGui(){
+    if(!guiLock.owns_lock()) guiLock.lock();
+}
+
+void ofxOceanodeContainer::unlockGui(){
+    if(guiLock.owns_lock()) guiLock.unlock();
+}
+
+void ofxOceanodeContainer::update(ofEventArgs &args){
+    if(engine == nullptr){
+        tick(args);
+    }
+#ifdef OFXOCEANODE_USE_OSC
+    processOscCommands();
+#endif
+    //Draw doesn't lock the engine, the guis draw the values copied here
+    if(!isHeadless){
+        for(auto &nodeTypeMap : dynamicNodes){
+            for(auto &node : nodeTypeMap.second){
+                node.second->getNodeGui().updateSnapshot();
+            }
+        }
+        for(auto &nodeTypeMap : persistentNodes){
+            for(auto &node : nodeTypeMap.second){
+                node.second->getNodeGui().updateSnapshot();
+            }
+        }
+    }
+}
+
+void ofxOceanodeContainer::tick(ofEventArgs &args){
+#ifdef OFXOCEANODE_USE_OSC
+    receiveOscMessages();
+#endif
+#ifdef OFXOCEANODE_USE_MIDI
+    receiveMidiMessages();
+#endif
+    if(scheduleDirty){
+        compileSchedule();
+    }
+    if(threadPool != nullptr && !engineDeterministic && scheduleTasks.size() > 1){
+        tickArgs = &args;
+        parallelTickRunning = true;
+        threadPool->run(scheduleTasks);
+        parallelTickRunning = false;
+        applyDeferredGraphChanges();
+    }else{
+        for(auto node : schedule){
+            node->propagateInConnections();
+            node->update(args);
+            if(scheduleDirty) break;
+        }
+    }
+    //A node changed the graph (preset load, node deleted...), the rest is done next tick
+    if(scheduleDirty) return;
+#ifdef OFXOCEANODE_USE_OSC
+    sendOscOutputs();
+#endif
+#ifdef OFXOCEANODE_USE_MIDI
+    sendMidiOutputs();
+#endif
+}
+
+void ofxOceanodeContainer::compileSchedule(){
+    //Topological order of the nodes (Kahn), so every node is evaluated once per tick after all its sources
+    vector<ofxOceanodeNode*> nodes;
+    for(auto &nodeTypeMap : dynamicNodes){
+        for(auto &node : nodeTypeMap.second){
+            if(node.second != nullptr) nodes.push_back(node.second.get());
+        }
+    }
+    for(auto &nodeTypeMap : persistentNodes){
+        for(auto &node : nodeTypeMap.second){
+            if(node.second != nullptr) nodes.push_back(node.second.get());
+        }
+    }
+    
+    std::unordered_map<ofxOceanodeNode*, int> nodeIndex;
+    for(int i = 0; i < nodes.size(); i++){
+        nodeIndex[nodes[i]] = i;
+    }
+    vector<vector<int>> edges(nodes.size());
+    vector<int> inDegree(nodes.size(), 0);
+    for(auto &c : connections){
+        auto source = nodeIndex.find(c->getSourceNode());
+        auto sink = nodeIndex.find(c->getSinkNode());
+        if(source == nodeIndex.end() || sink == nodeIndex.end() || source->second == sink->second) continue;
+        edges[source->second].push_back(sink->second);
+        inDegree[sink->second]++;
+    }
+    
+    schedule.clear();
+    vector<bool> scheduled(nodes.size(), false);
+    for(int i = 0; i < nodes.size(); i++){
+        if(inDegree[i] == 0){
+            schedule.push_back(nodes[i]);
+            scheduled[i] = true;
+        }
+    }
+    for(int i = 0; i < schedule.size(); i++){
+        for(auto sink : edges[nodeIndex[schedule[i]]]){
+            if(--inDegree[sink] == 0){
+                schedule.push_back(nodes[sink]);
+                scheduled[sink] = true;
+            }
+        }
+    }
+    //Nodes in a feedback loop can't be sorted, they go at the end and see the loop values one tick late
+    for(int i = 0; i < nodes.size(); i++){
+        if(!scheduled[i]) schedule.push_back(nodes[i]);
+    }
+    
+    //Split the schedule in weakly connected groups, they don't share any connection and can be ticked in parallel
+    vector<int> groupRoot(nodes.size());
+    for(int i = 0; i < nodes.size(); i++){
+        groupRoot[i] = i;
+    }
+    std::function<int(int)> findRoot = [&groupRoot, &findRoot](int i){
+        if(groupRoot[i] != i) groupRoot[i] = findRoot(groupRoot[i]);
+        return groupRoot[i];
+    };
+    for(int i = 0; i < nodes.size(); i++){
+        for(auto sink : edges[i]){
+            groupRoot[findRoot(i)] = findRoot(sink);
+        }
+    }
+    scheduleGroups.clear();
+    std::unordered_map<int, int> rootToGroup;
+    for(auto node : schedule){
+        int root = findRoot(nodeIndex[node]);
+        if(rootToGroup.count(root) == 0){
+            rootToGroup[root] = scheduleGroups.size();
+            scheduleGroups.emplace_back();
+        }
+        scheduleGroups[rootToGroup[root]].push_back(node);
+    }
+    scheduleTasks.clear();
+    for(int i = 0; i < scheduleGroups.size(); i++){
+        scheduleTasks.push_back([this, i](){
+            for(auto node : scheduleGroups[i]){
+                if(scheduleDirty) return;
+                node->propagateInConnections();
+                node->update(*tickArgs);
+            }
+        });
+    }
+    scheduleDirty = false;
+}
+
 #ifdef OFXOCEANODE_USE_OSC
 
 void ofxOceanodeContainer::setupOscSender(string host, int port){
-    oscSender.setup(host, port);
+    oscSenderReady = oscSender.setup(host, port);
 }
 
 void ofxOceanodeContainer::setupOscReceiver(int port){
     oscReceiver.setup(port);
 }
 
-void ofxOceanodeContainer::update(ofEventArgs &args){
-    
-    auto setParameterFromMidiMessage = [this](ofAbstractParameter& absParam, ofxOscMessage& m){
-        if(absParam.type() == typeid(ofParameter<float>).name()){
-            ofParameter<float> castedParam = absParam.cast<float>();
-            castedParam = ofMap(m.getArgAsFloat(0), 0, 1, castedParam.getMin(), castedParam.getMax(), true);
-        }else if(absParam.type() == typeid(ofParameter<int>).name()){
-            ofParameter<int> castedParam = absParam.cast<int>();
-            castedParam = ofMap(m.getArgAsFloat(0), 0, 1, castedParam.getMin(), castedParam.getMax(), true);
-        }else if(absParam.type() == typeid(ofParameter<bool>).name()){
-            absParam.cast<bool>() = m.getArgAsBool(0);
-        }else if(absParam.type() == typeid(ofParameter<void>).name()){
-            absParam.cast<void>().trigger();
-        }else if(absParam.type() == typeid(ofParameter<string>).name()){
-            absParam.cast<string>() = m.getArgAsString(0);
-        }else if(absParam.type() == typeid(ofParameterGroup).name()){
-            absParam.castGroup().getInt(1) = m.getArgAsInt(0);
-        }else if(absParam.type() == typeid(ofParameter<vector<float>>).name()){
-            ofParameter<vector<float>> castedParam = absParam.cast<vector<float>>();
-            vector<float> tempVec;
-            tempVec.resize(m.getNumArgs(), 0);
-            for(int i = 0; i < tempVec.size(); i++){
-                tempVec[i] = ofMap(m.getArgAsFloat(i), 0, 1, castedParam.getMin()[0], castedParam.getMax()[0], true);
-            }
-            castedParam = tempVec;
-        }
-        else if(absParam.type() == typeid(ofParameter<vector<int>>).name()){
-            ofParameter<vector<int>> castedParam = absParam.cast<vector<int>>();
-            vector<int> tempVec;
-            tempVec.resize(m.getNumArgs(), 0);
-            if(m.getArgType(0) == ofxOscArgType::OFXOSC_TYPE_FLOAT){
-                for(int i = 0; i < tempVec.size(); i++){
-                    tempVec[i] = ofMap(m.getArgAsFloat(i), 0, 1, castedParam.getMin()[0], castedParam.getMax()[0], true);
+void ofxOceanodeContainer::rebuildOscRoutes(){
+    //Taken before reading the nodes, a change made meanwhile (a worker changing a parameter group) rebuilds again
+    oscRoutesVersion = nodesVersion;
+    oscRoutes.clear();
+    auto addNodeRoutes = [this](std::unordered_map<string, nodeContainerWithId> &collection){
+        for(auto &nodeType : collection){
+            for(auto &node : nodeType.second){
+                ofParameterGroup* groupParam = node.second->getParameters();
+                string nodeAddress = "/" + groupParam->getEscapedName() + "/";
+                for(int i = 0; i < groupParam->size(); i++){
+                    ofAbstractParameter &absParam = groupParam->get(i);
+                    oscSetter setter = ofxOceanodeTypesRegistry::getOscConverter(absParam);
+                    if(setter == nullptr) continue;
+                    oscRoutes[nodeAddress + absParam.getEscapedName()].push_back(make_pair(&absParam, setter));
+                    oscRoutes["/Global/" + absParam.getEscapedName()].push_back(make_pair(&absParam, setter));
                 }
             }
-            else if(m.getArgType(0) == ofxOscArgType::OFXOSC_TYPE_INT32 || m.getArgType(0) == ofxOscArgType::OFXOSC_TYPE_INT64){
-                for(int i = 0; i < tempVec.size(); i++){
-                    tempVec[i] = ofClamp(m.getArgAsInt(i), castedParam.getMin()[0], castedParam.getMax()[0]);
+        }
+    };
+    addNodeRoutes(dynamicNodes);
+    addNodeRoutes(persistentNodes);
+}
+
+bool ofxOceanodeContainer::addOscOutput(ofAbstractParameter &p){
+    auto lock = lockEngine();
+    oscOutput output;
+    output.parameter = &p;
+    output.type = ofxOceanodeTypesRegistry::getTypeId(p);
+    if(!encodeOscOutput(output, oscOutputPayload)){
+        ofLog() << "Parameter \"" << p.getEscapedName() << "\" can't be sent by osc";
+        return false;
+    }
+    return addOscOutput("/" + p.getGroupHierarchyNames()[0] + "/" + p.getEscapedName());
+}
+
+bool ofxOceanodeContainer::addOscOutput(string address){
+    //The outputs are read by the engine tick
+    auto lock = lockEngine();
+    for(auto &output : oscOutputs){
+        if(output.address == address) return true;
+    }
+    oscOutput output;
+    output.address = address;
+    oscOutputs.push_back(output);
+    //Resolved on the next tick
+    oscOutputsVersion = 0;
+    return true;
+}
+
+void ofxOceanodeContainer::removeOscOutput(ofAbstractParameter &p){
+    removeOscOutput("/" + p.getGroupHierarchyNames()[0] + "/" + p.getEscapedName());
+}
+
+void ofxOceanodeContainer::removeOscOutput(string address){
+    auto lock = lockEngine();
+    oscOutputs.erase(std::remove_if(oscOutputs.begin(), oscOutputs.end(), [&address](const oscOutput &output){
+        return output.address == address;
+    }), oscOutputs.end());
+}
+
+void ofxOceanodeContainer::setOscOutputRate(float rate){
+    auto lock = lockEngine();
+    oscOutputRate = rate;
+}
+
+void ofxOceanodeContainer::setOscOutputChangesOnly(bool b){
+    auto lock = lockEngine();
+    oscOutputChangesOnly = b;
+}
+
+void ofxOceanodeContainer::resolveOscOutputs(){
+    oscOutputsVersion = nodesVersion;
+    std::unordered_map<string, ofAbstractParameter*> parameters;
+    auto addNodeParameters = [&parameters](std::unordered_map<string, nodeContainerWithId> &collection){
+        for(auto &nodeType : collection){
+            for(auto &node : nodeType.second){
+                ofParameterGroup* groupParam = node.second->getParameters();
+                string nodeAddress = "/" + groupParam->getEscapedName() + "/";
+                for(int i = 0; i < groupParam->size(); i++){
+                    parameters[nodeAddress + groupParam->get(i).getEscapedName()] = &groupParam->get(i);
                 }
             }
-            castedParam = tempVec;
         }
     };
+    addNodeParameters(dynamicNodes);
+    addNodeParameters(persistentNodes);
+    
+    for(auto &output : oscOutputs){
+        auto parameter = parameters.find(output.address);
+        ofAbstractParameter *resolved = parameter != parameters.end() ? parameter->second : nullptr;
+        int type = resolved != nullptr ? ofxOceanodeTypesRegistry::getTypeId(*resolved) : OFXOCEANODE_TYPE_UNKNOWN;
+        if(resolved != output.parameter || type != output.type){
+            output.parameter = resolved;
+            output.type = type;
+            output.sent = false;
+        }
+    }
+}
+
+bool ofxOceanodeContainer::encodeOscOutput(const oscOutput &output, string &payload){
+    ofAbstractParameter &absParam = *output.parameter;
+    switch(output.type){
+        case OFXOCEANODE_TYPE_FLOAT:{
+            float value = absParam.cast<float>();
+            payload.assign(reinterpret_cast<const char*>(&value), sizeof(value));
+            return true;
+        }
+        case OFXOCEANODE_TYPE_INT:
+        case OFXOCEANODE_TYPE_DROPDOWN:{
+            int32_t value = output.type == OFXOCEANODE_TYPE_INT ? absParam.cast<int>().get() : absParam.castGroup().getInt(1).get();
+            payload.assign(reinterpret_cast<const char*>(&value), sizeof(value));
+            return true;
+        }
+        case OFXOCEANODE_TYPE_BOOL:
+            payload.assign(1, absParam.cast<bool>() ? 1 : 0);
+            return true;
+        case OFXOCEANODE_TYPE_STRING:
+            payload = absParam.cast<string>();
+            return true;
+        case OFXOCEANODE_TYPE_VECTOR_FLOAT:{
+            const vector<float> &value = absParam.cast<vector<float>>().get();
+            payload.assign(reinterpret_cast<const char*>(value.data()), value.size() * sizeof(float));
+            return true;
+        }
+        case OFXOCEANODE_TYPE_BUFFER:{
+            const ofxOceanodeBuffer &value = absParam.cast<ofxOceanodeBuffer>().get();
+            payload.assign(reinterpret_cast<const char*>(value.data()), value.size() * sizeof(float));
+            return true;
+        }
+        case OFXOCEANODE_TYPE_VECTOR_INT:{
+            const vector<int> &value = absParam.cast<vector<int>>().get();
+            payload.resize(value.size() * sizeof(float));
+            float *floats = reinterpret_cast<float*>(&payload[0]);
+            for(int i = 0; i < value.size(); i++){
+                floats[i] = value[i];
+            }
+            return true;
+        }
+        default:
+            return false;
+    }
+}
+
+void ofxOceanodeContainer::addOscOutputArgs(const oscOutput &output, const string &payload, ofxOscMessage &m){
+    switch(output.type){
+        case OFXOCEANODE_TYPE_FLOAT:
+            m.addFloatArg(*reinterpret_cast<const float*>(payload.data()));
+            break;
+        case OFXOCEANODE_TYPE_INT:
+        case OFXOCEANODE_TYPE_DROPDOWN:
+            m.addIntArg(*reinterpret_cast<const int32_t*>(payload.data()));
+            break;
+        case OFXOCEANODE_TYPE_BOOL:
+            m.addBoolArg(payload[0] != 0);
+            break;
+        case OFXOCEANODE_TYPE_STRING:
+            m.addStringArg(payload);
+            break;
+        case OFXOCEANODE_TYPE_VECTOR_FLOAT:
+        case OFXOCEANODE_TYPE_VECTOR_INT:
+        case OFXOCEANODE_TYPE_BUFFER:
+            m.addBlobArg(ofBuffer(payload.data(), payload.size()));
+            break;
+        default:
+            break;
+    }
+}
+
+void ofxOceanodeContainer::sendOscOutputs(){
+    if(!oscSenderReady || oscOutputs.empty()) return;
+    auto now = std::chrono::steady_clock::now();
+    if(oscOutputRate > 0 && now - lastOscOutputTime < std::chrono::duration<float>(1.0f / oscOutputRate)) return;
+    lastOscOutputTime = now;
+    
+    if(oscOutputsVersion != nodesVersion){
+        resolveOscOutputs();
+    }
     
-    while(oscReceiver.hasWaitingMessages()){
+    ofxOscBundle bundle;
+    for(auto &output : oscOutputs){
+        if(output.parameter == nullptr) continue;
+        if(!encodeOscOutput(output, oscOutputPayload)) continue;
+        if(oscOutputChangesOnly && output.sent && oscOutputPayload == output.lastPayload) continue;
         ofxOscMessage m;
-        oscReceiver.getNextMessage(m);
+        m.setAddress(output.address);
+        addOscOutputArgs(output, oscOutputPayload, m);
+        bundle.addMessage(m);
+        std::swap(output.lastPayload, oscOutputPayload);
+        output.sent = true;
+    }
+    if(bundle.getMessageCount() > 0){
+        oscSender.sendBundle(bundle);
+    }
+}
+
+void ofxOceanodeContainer::receiveOscMessages(){
+    ofxOscMessage m;
+    while(oscReceiver.popMessage(m)){
+        //A previous tick can have loaded a preset or changed the nodes
+        if(oscRoutesVersion != nodesVersion){
+            rebuildOscRoutes();
+            oscTickMessages.clear();
+            oscTickMessageIndex.clear();
+        }
         
+        //Parameter addresses are resolved with a single lookup
+        auto route = oscRoutes.find(m.getAddress());
+        if(route == oscRoutes.end()){
+            string address = m.getAddress();
+            ofStringReplace(address, " ", "_");
+            if(address.size() > 0 && address[0] != '/') address = "/" + address;
+            route = oscRoutes.find(address);
+        }
+        if(route == oscRoutes.end()){
+            oscCommands.push_back(std::move(m));
+            continue;
+        }
+        
+        //Void parameters are triggers, every message has to fire them so they are never coalesced
+        bool isTrigger = std::any_of(route->second.begin(), route->second.end(), [](const pair<ofAbstractParameter*, oscSetter> &target){
+            return ofxOceanodeTypesRegistry::getTypeId(*target.first) == OFXOCEANODE_TYPE_VOID;
+        });
+        if(oscCoalescing && !isTrigger){
+            auto index = oscTickMessageIndex.find(&route->first);
+            if(index != oscTickMessageIndex.end()){
+                oscTickMessages[index->second].second = std::move(m);
+                continue;
+            }
+            oscTickMessageIndex[&route->first] = oscTickMessages.size();
+        }
+        oscTickMessages.emplace_back(route, std::move(m));
+    }
+    
+    for(auto &message : oscTickMessages){
+        for(auto &target : message.first->second){
+            target.second(*target.first, message.second);
+        }
+    }
+    oscTickMessages.clear();
+    oscTickMessageIndex.clear();
+}
+
+void ofxOceanodeContainer::processOscCommands(){
+    if(oscCommands.empty()) return;
+    auto commands = std::move(oscCommands);
+    oscCommands.clear();
+    for(auto &m : commands){
         vector<string> splitAddress = ofSplitString(m.getAddress(), "/");
         if(splitAddress[0].size() == 0) splitAddress.erase(splitAddress.begin());
         if(splitAddress.size() == 1){
@@ -712,7 +1254,7 @@ void ofxOceanodeContainer::update(ofEventArgs &args){
                 map<int, string> presets;
                 dir.open("Presets/" + bankName);
                 if(!dir.exists())
-                    return;
+                    continue;
                 dir.sort();
                 int numPresets = dir.listDir();
                 for ( int i = 0 ; i < numPresets; i++){
@@ -724,48 +1266,6 @@ void ofxOceanodeContainer::update(ofEventArgs &args){
                 }
             }else if(splitAddress[0] == "presetSave"){
                 savePreset("Presets/" + splitAddress[1] + "/" + m.getArgAsString(0));
-            }else if(splitAddress[0] == "Global"){
-                for(auto &nodeType  : dynamicNodes){
-                    for(auto &node : nodeType.second){
-                        ofParameterGroup* groupParam = node.second->getParameters();
-                        if(groupParam->contains(splitAddress[1])){
-                            ofAbstractParameter &absParam = groupParam->get(splitAddress[1]);
-                            setParameterFromMidiMessage(absParam, m);
-                        }
-                    }
-                }
-                for(auto &nodeType  : persistentNodes){
-                    for(auto &node : nodeType.second){
-                        ofParameterGroup* groupParam = node.second->getParameters();
-                        if(groupParam->contains(splitAddress[1])){
-                            ofAbstractParameter &absParam = groupParam->get(splitAddress[1]);
-                            setParameterFromMidiMessage(absParam, m);
-                        }
-                    }
-                }
-            }else{
-                string moduleName = splitAddress[0];
-                string moduleId = ofSplitString(moduleName, "_").back();
-                moduleName.erase(moduleName.find(moduleId)-1);
-                ofStringReplace(moduleName, "_", " ");
-                if(dynamicNodes.count(moduleName) == 1){
-                    if(dynamicNodes[moduleName].count(ofToInt(moduleId))){
-                        ofParameterGroup* groupParam = dynamicNodes[moduleName][ofToInt(moduleId)]->getParameters();
-                        if(groupParam->contains(splitAddress[1])){
-                            ofAbstractParameter &absParam = groupParam->get(splitAddress[1]);
-                            setParameterFromMidiMessage(absParam, m);
-                        }
-                    }
-                }
-                if(persistentNodes.count(moduleName) == 1){
-                    if(persistentNodes[moduleName].count(ofToInt(moduleId))){
-                        ofParameterGroup* groupParam = persistentNodes[moduleName][ofToInt(moduleId)]->getParameters();
-                        if(groupParam->contains(splitAddress[1])){
-                            ofAbstractParameter &absParam = groupParam->get(splitAddress[1]);
-                            setParameterFromMidiMessage(absParam, m);
-                        }
-                    }
-                }
             }
         }
         else if(splitAddress.size() == 3){
@@ -799,42 +1299,52 @@ void ofxOceanodeContainer::setIsListeningMidi(bool b){
 ofxOceanodeAbstractMidiBinding* ofxOceanodeContainer::createMidiBinding(ofAbstractParameter &p, bool isPersistent){
     if(midiBindings.count(p.getGroupHierarchyNames()[0] + "-|-" + p.getEscapedName()) == 0 && persistentMidiBindings.count(p.getGroupHierarchyNames()[0] + "-|-" + p.getEscapedName()) == 0){
         unique_ptr<ofxOceanodeAbstractMidiBinding> midiBinding = nullptr;
-        if(p.type() == typeid(ofParameter<float>).name()){
-            midiBinding = make_unique<ofxOceanodeMidiBinding<float>>(p.cast<float>());
-        }
-        else if(p.type() == typeid(ofParameter<int>).name()){
-            midiBinding = make_unique<ofxOceanodeMidiBinding<int>>(p.cast<int>());
-        }
-        else if(p.type() == typeid(ofParameter<bool>).name()){
-            midiBinding = make_unique<ofxOceanodeMidiBinding<bool>>(p.cast<bool>());
-        }
-        else if(p.type() == typeid(ofParameter<void>).name()){
-            midiBinding = make_unique<ofxOceanodeMidiBinding<void>>(p.cast<void>());
-        }
-        else if(p.type() == typeid(ofParameter<vector<float>>).name()){
-            midiBinding = make_unique<ofxOceanodeMidiBinding<vector<float>>>(p.cast<vector<float>>());
-        }
-        else if(p.type() == typeid(ofParameter<vector<int>>).name()){
-            midiBinding = make_unique<ofxOceanodeMidiBinding<vector<int>>>(p.cast<vector<int>>());
-        }
-        else if(p.type() == typeid(ofParameterGroup).name()){
-            midiBinding = make_unique<ofxOceanodeMidiBinding<int>>(p.castGroup().getInt(1));
-        }
-        else if(p.type() == typeid(ofParameter<pair<int, bool>>).name()){
-            midiBinding = make_unique<ofxOceanodeMidiBinding<pair<int, bool>>>(p.cast<pair<int, bool>>());
+        switch(ofxOceanodeTypesRegistry::getTypeId(p)){
+            case OFXOCEANODE_TYPE_FLOAT:
+                midiBinding = make_unique<ofxOceanodeMidiBinding<float>>(p.cast<float>());
+                break;
+            case OFXOCEANODE_TYPE_INT:
+                midiBinding = make_unique<ofxOceanodeMidiBinding<int>>(p.cast<int>());
+                break;
+            case OFXOCEANODE_TYPE_BOOL:
+                midiBinding = make_unique<ofxOceanodeMidiBinding<bool>>(p.cast<bool>());
+                break;
+            case OFXOCEANODE_TYPE_VOID:
+                midiBinding = make_unique<ofxOceanodeMidiBinding<void>>(p.cast<void>());
+                break;
+            case OFXOCEANODE_TYPE_VECTOR_FLOAT:
+                midiBinding = make_unique<ofxOceanodeMidiBinding<vector<float>>>(p.cast<vector<float>>());
+                break;
+            case OFXOCEANODE_TYPE_VECTOR_INT:
+                midiBinding = make_unique<ofxOceanodeMidiBinding<vector<int>>>(p.cast<vector<int>>());
+                break;
+            case OFXOCEANODE_TYPE_BUFFER:
+                midiBinding = make_unique<ofxOceanodeMidiBinding<ofxOceanodeBuffer>>(p.cast<ofxOceanodeBuffer>());
+                break;
+            case OFXOCEANODE_TYPE_DROPDOWN:
+                midiBinding = make_unique<ofxOceanodeMidiBinding<int>>(p.castGroup().getInt(1));
+                break;
+            case OFXOCEANODE_TYPE_PAIR_INT_BOOL:
+                midiBinding = make_unique<ofxOceanodeMidiBinding<pair<int, bool>>>(p.cast<pair<int, bool>>());
+                break;
+            default:
+                break;
         }
         if(midiBinding != nullptr){
-            for(auto &midiInPair : midiIns){
-                midiInPair.second.addListener(midiBinding.get());
-            }
             midiBindingCreated.notify(this, *midiBinding.get());
             midiUnregisterlisteners.push(midiBinding->unregisterUnusedMidiIns.newListener(this, &ofxOceanodeContainer::midiBindingBound));
+            //Changing the binding from the gui moves it in the dispatch table
+            midiUnregisterlisteners.push(midiBinding->getChannel().newListener([this](int &){midiDispatchDirty = true;}));
+            midiUnregisterlisteners.push(midiBinding->getControl().newListener([this](int &){midiDispatchDirty = true;}));
+            midiUnregisterlisteners.push(midiBinding->getMessageType().newListener([this](string &){midiDispatchDirty = true;}));
             auto midiBindingPointer = midiBinding.get();
+            std::lock_guard<std::recursive_mutex> midiLock(midiDispatchMutex);
             if(!isPersistent){
                 midiBindings[p.getGroupHierarchyNames()[0] + "-|-" + p.getEscapedName()] = move(midiBinding);
             }else{
                 persistentMidiBindings[p.getGroupHierarchyNames()[0] + "-|-" + p.getEscapedName()] = move(midiBinding);
             }
+            midiDispatchDirty = true;
             return midiBindingPointer;
         }
     }else{
@@ -846,11 +1356,10 @@ ofxOceanodeAbstractMidiBinding* ofxOceanodeContainer::createMidiBinding(ofAbstra
 bool ofxOceanodeContainer::removeMidiBinding(ofAbstractParameter &p){
     string midiBindingName = p.getGroupHierarchyNames()[0] + "-|-" + p.getEscapedName();
     if(midiBindings.count(midiBindingName) != 0){
-        for(auto &midiInPair : midiIns){
-            midiInPair.second.removeListener(midiBindings[midiBindingName].get());
-        }
+        std::lock_guard<std::recursive_mutex> midiLock(midiDispatchMutex);
         midiBindingDestroyed.notify(this, *midiBindings[midiBindingName].get());
         midiBindings.erase(midiBindingName);
+        midiDispatchDirty = true;
         return true;
     }
     return false;
@@ -858,30 +1367,99 @@ bool ofxOceanodeContainer::removeMidiBinding(ofAbstractParameter &p){
 
 void ofxOceanodeContainer::midiBindingBound(const void * sender, string &portName){
     ofxOceanodeAbstractMidiBinding * midiBinding = static_cast <ofxOceanodeAbstractMidiBinding *> (const_cast <void *> (sender));
-    for(auto &midiInPair : midiIns){
-        if(midiInPair.first != portName){
-            midiInPair.second.removeListener(midiBinding);
-        }
-    }
+    //From now on it only receives the messages of its port
+    midiDispatchDirty = true;
     if(midiOuts.count(portName) != 0){
+        int port = std::find(midiOutPortList.begin(), midiOutPortList.end(), portName) - midiOutPortList.begin();
+        bool isTrigger = midiBinding->isTrigger();
         midiBinding->bindParameter();
-        midiSenderListeners.push(midiBinding->midiMessageSender.newListener([this, portName](ofxMidiMessage& message){
-            switch(message.status){
-                case MIDI_CONTROL_CHANGE:{
-                    midiOuts[portName].sendControlChange(message.channel, message.control, message.value);
-                    break;
-                }
-                case MIDI_NOTE_ON:{
-                    midiOuts[portName].sendNoteOn(message.channel, message.pitch, message.velocity);
-                }
-                default:{
-                    
-                }
-            }
+        midiSenderListeners.push(midiBinding->midiMessageSender.newListener([this, midiBinding, port, isTrigger](ofxMidiMessage& message){
+            queueMidiOutput(midiBinding, port, message, isTrigger);
         }));
     }
 }
 
+void ofxOceanodeContainer::queueMidiOutput(ofxOceanodeAbstractMidiBinding *binding, int port, ofxMidiMessage &message, bool isTrigger){
+    midiOutput output;
+    output.binding = binding;
+    output.port = port;
+    output.status = message.status;
+    output.channel = message.channel;
+    switch(message.status){
+        case MIDI_CONTROL_CHANGE:
+            output.control = message.control;
+            output.value = message.value;
+            break;
+        case MIDI_NOTE_ON:
+            output.control = message.pitch;
+            output.value = message.velocity;
+            break;
+        default:
+            return;
+    }
+    //Parameters can change from the gui or from nodes ticked in parallel
+    std::lock_guard<std::mutex> lock(midiOutputMutex);
+    if(isTrigger){
+        midiOutputTriggers.push_back(output);
+        return;
+    }
+    auto &pendingOutput = midiOutputs[binding];
+    //A binding moved to another control sends its first value again
+    if(pendingOutput.port == output.port && pendingOutput.status == output.status && pendingOutput.channel == output.channel && pendingOutput.control == output.control){
+        output.sentValue = pendingOutput.sentValue;
+    }
+    output.lastSentTime = pendingOutput.lastSentTime;
+    output.pending = true;
+    pendingOutput = output;
+}
+
+void ofxOceanodeContainer::dropMidiOutputs(ofxOceanodeAbstractMidiBinding *binding){
+    std::lock_guard<std::mutex> lock(midiOutputMutex);
+    midiOutputs.erase(binding);
+    midiOutputTriggers.erase(std::remove_if(midiOutputTriggers.begin(), midiOutputTriggers.end(), [binding](const midiOutput &output){
+        return output.binding == binding;
+    }), midiOutputTriggers.end());
+}
+
+void ofxOceanodeContainer::sendMidiOutput(const midiOutput &output){
+    ofxMidiOut &midiOut = midiOuts[midiOutPortList[output.port]];
+    switch(output.status){
+        case MIDI_CONTROL_CHANGE:
+            midiOut.sendControlChange(output.channel, output.control, output.value);
+            break;
+        case MIDI_NOTE_ON:
+            midiOut.sendNoteOn(output.channel, output.control, output.value);
+            break;
+        default:
+            break;
+    }
+}
+
+void ofxOceanodeContainer::sendMidiOutputs(){
+    std::lock_guard<std::mutex> lock(midiOutputMutex);
+    for(auto &output : midiOutputTriggers){
+        sendMidiOutput(output);
+    }
+    midiOutputTriggers.clear();
+    
+    //Each binding has its own rate limit, a value that has to wait stays pending until its binding can send again
+    auto now = std::chrono::steady_clock::now();
+    auto minInterval = std::chrono::duration<float>(midiOutputRate > 0 ? 1.0f / midiOutputRate : 0);
+    for(auto &outputPair : midiOutputs){
+        midiOutput &output = outputPair.second;
+        if(!output.pending) continue;
+        if(midiOutputChangesOnly && output.value == output.sentValue){
+            output.pending = false;
+            continue;
+        }
+        if(now - output.lastSentTime < minInterval) continue;
+        output.pending = false;
+        sendMidiOutput(output);
+        output.sentValue = output.value;
+        output.lastSentTime = now;
+    }
+}
+
 ofxOceanodeAbstractMidiBinding* ofxOceanodeContainer::createMidiBindingFromInfo(string module, string parameter, bool isPersistent){
     auto &collection = !isPersistent ? dynamicNodes : persistentNodes;
     string moduleId = ofSplitString(module, "_").back();
@@ -901,10 +1479,170 @@ ofxOceanodeAbstractMidiBinding* ofxOceanodeContainer::createMidiBindingFromInfo(
     }
 }
 
+void ofxOceanodeContainer::rebuildMidiDispatch(){
+    midiDispatchTable.clear();
+    midiLearningBindings.clear();
+    for(auto &portBindings : midiPortBindings){
+        portBindings.clear();
+    }
+    auto addBindings = [this](map<string, unique_ptr<ofxOceanodeAbstractMidiBinding>> &bindings){
+        for(auto &bindingPair : bindings){
+            ofxOceanodeAbstractMidiBinding* binding = bindingPair.second.get();
+            if(binding->getIsListening()){
+                midiLearningBindings.push_back(binding);
+                continue;
+            }
+            auto port = std::find(midiInPortList.begin(), midiInPortList.end(), binding->getPortName());
+            if(port == midiInPortList.end()) continue;
+            int portIndex = port - midiInPortList.begin();
+            if(binding->dispatchByControl()){
+                midiDispatchTable[midiDispatchKey(portIndex, binding->getChannel(), binding->getStatus(), binding->getControl())].push_back(binding);
+            }else{
+                midiPortBindings[portIndex].push_back(binding);
+            }
+        }
+    };
+    addBindings(midiBindings);
+    addBindings(persistentMidiBindings);
+}
+
+void ofxOceanodeContainer::openMidiInPort(string port, bool isVirtual){
+    if(isVirtual){
+        midiIns[port].openVirtualPort(port);
+    }else{
+        midiIns[port].openPort(port);
+    }
+    if(std::find(midiInPortList.begin(), midiInPortList.end(), port) == midiInPortList.end()){
+        midiInPortList.push_back(port);
+    }
+    midiPortListeners.push_back(make_unique<ofxOceanodeMidiPortListener>());
+    midiIns[port].addListener(midiPortListeners.back().get());
+    std::lock_guard<std::recursive_mutex> midiLock(midiDispatchMutex);
+    midiPortBindings.resize(midiInPortList.size());
+    midiDispatchDirty = true;
+}
+
+void ofxOceanodeContainer::setMidiClockPort(string port){
+    std::unique_lock<std::recursive_timed_mutex> lock(engineMutex);
+    if(midiClockPortIndex != -1){
+        midiIns[midiClockPort].ignoreTypes(true, true, true);
+    }
+    midiClockPort = port;
+    midiClockPortIndex = -1;
+    midiClock = ofxOceanodeMidiClock(midiClock.getBandwidth());
+    //A stopped midi clock doesn't keep the transport stopped
+    clock->setBeat(ofxOceanodeClock::getBeat(clock->getTransport(), ofxOceanodeClock::now()), true);
+    if(port == "") return;
+    
+    if(std::find(midiInPortList.begin(), midiInPortList.end(), port) == midiInPortList.end()){
+        openMidiInPort(port, true);
+    }
+    midiClockPortIndex = std::find(midiInPortList.begin(), midiInPortList.end(), port) - midiInPortList.begin();
+    //Timing messages are ignored by default
+    midiIns[port].ignoreTypes(true, false, true);
+}
+
+void ofxOceanodeContainer::receiveMidiMessages(){
+    //Merge the port queues in arrival order
+    ofxOceanodeMidiPortListener::timedMessage m;
+    while(true){
+        int earliestPort = -1;
+        for(int i = 0; i < midiPortListeners.size(); i++){
+            auto front = midiPortListeners[i]->front();
+            if(front != nullptr && (earliestPort == -1 || front->timestamp < midiPortListeners[earliestPort]->front()->timestamp)){
+                earliestPort = i;
+            }
+        }
+        if(earliestPort == -1) break;
+        midiPortListeners[earliestPort]->popMessage(m);
+        double time = std::chrono::duration<double>(m.timestamp.time_since_epoch()).count();
+        if(earliestPort == midiClockPortIndex && m.message.status >= MIDI_SYSEX){
+            receiveMidiClockMessage(m.message, time);
+            continue;
+        }
+        dispatchMidiMessage(earliestPort, m.message, time);
+    }
+}
+
+void ofxOceanodeContainer::receiveMidiClockMessage(ofxMidiMessage &message, double time){
+    std::unique_lock<std::recursive_timed_mutex> lock(engineMutex);
+    //Phasors see the tempo, the restart and the beat position of a message on the same clock wake
+    auto clockLock = clock->lockPhasors();
+    switch(message.status){
+        case MIDI_TIME_CLOCK:
+            //The song starts on the first pulse after start, not on the start message itself
+            if(midiClock.clock(time)){
+                resetPhaseAt(time);
+            }
+            if(midiClock.isLocked() && std::abs(midiClock.getBpm() - bpm) > 0.01){
+                setBpm(midiClock.getBpm());
+            }
+            break;
+        case MIDI_START:
+            midiClock.start(time);
+            break;
+        case MIDI_CONTINUE:
+            midiClock.continuePlaying(time);
+            break;
+        case MIDI_STOP:
+            midiClock.stop();
+            break;
+        case MIDI_SONG_POS_POINTER:
+            if(message.bytes.size() >= 3){
+                midiClock.songPosition(message.bytes[1] | (message.bytes[2] << 7));
+            }
+            break;
+        default:
+            return;
+    }
+    //The beat position of the clock drives the transport, phasors at the container bpm follow it (song position
+    //included) and stop with it. Between pulses the transport advances at the container bpm
+    clock->setBeat(midiClock.getBeatPosition(time), midiClock.isRunning() && !midiClock.isWaitingFirstPulse(), time);
+}
+
+void ofxOceanodeContainer::dispatchMidiMessage(int port, ofxMidiMessage &message, double time){
+    std::lock_guard<std::recursive_mutex> midiLock(midiDispatchMutex);
+    if(midiDispatchDirty.exchange(false)){
+        rebuildMidiDispatch();
+    }
+    midiMessageTime = time;
+    for(auto listener : midiMessageListeners){
+        listener->newMidiMessage(message);
+    }
+    
+    //Bindings treat note off as note on with velocity 0, look them up the same way
+    MidiStatus status = message.status == MIDI_NOTE_OFF ? MIDI_NOTE_ON : message.status;
+    //Bindings that learn from this message are moved to the table on the next rebuild
+    for(auto binding : midiLearningBindings){
+        binding->setLastMessageTime(time);
+        binding->newMidiMessage(message);
+    }
+    if(status == MIDI_CONTROL_CHANGE || status == MIDI_NOTE_ON){
+        auto bindings = midiDispatchTable.find(midiDispatchKey(port, message.channel, status, status == MIDI_CONTROL_CHANGE ? message.control : message.pitch));
+        if(bindings != midiDispatchTable.end()){
+            for(auto binding : bindings->second){
+                binding->setLastMessageTime(time);
+                binding->newMidiMessage(message);
+            }
+        }
+    }
+    for(auto binding : midiPortBindings[port]){
+        binding->setLastMessageTime(time);
+        binding->newMidiMessage(message);
+    }
+}
+
 void ofxOceanodeContainer::addNewMidiMessageListener(ofxMidiListener* listener){
-    for(auto &midiInPair : midiIns){
-        midiInPair.second.addListener(listener);
+    std::lock_guard<std::recursive_mutex> midiLock(midiDispatchMutex);
+    midiMessageListeners.push_back(listener);
+}
+
+uint64_t ofxOceanodeContainer::getMidiDroppedMessages(){
+    uint64_t dropped = 0;
+    for(auto &listener : midiPortListeners){
+        dropped += listener->getDroppedMessages();
     }
+    return dropped;
 }
 
 #endif
@@ -918,23 +1656,18 @@ ofxOceanodeAbstractConnection* ofxOceanodeContainer::createConnectionFromInfo(st
     sinkModule.erase(sinkModule.find(sinkModuleId)-1);
     ofStringReplace(sinkModule, "_", " ");
     
-    bool sourceIsDynamic = false;
-    if(dynamicNodes.count(sourceModule) == 1){
-        if(dynamicNodes[sourceModule].count(ofToInt(sourceModuleId)) == 1){
-            sourceIsDynamic = true;
-        }
-    }
-    
-    bool sinkIsDynamic = false;
-    if(dynamicNodes.count(sinkModule) == 1){
-        if(dynamicNodes[sinkModule].count(ofToInt(sinkModuleId)) == 1){
-            sinkIsDynamic = true;
+    //Looked up without inserting, a missing node would leave an empty entry in the node maps
+    auto findNode = [this](const string &module, int identifier) -> ofxOceanodeNode*{
+        for(auto collection : {&dynamicNodes, &persistentNodes}){
+            auto nodes = collection->find(module);
+            if(nodes == collection->end()) continue;
+            auto node = nodes->second.find(identifier);
+            if(node != nodes->second.end() && node->second != nullptr) return node->second.get();
         }
-    }
-    
-    
-    auto &sourceModuleRef = sourceIsDynamic ? dynamicNodes[sourceModule][ofToInt(sourceModuleId)] : persistentNodes[sourceModule][ofToInt(sourceModuleId)];
-    auto &sinkModuleRef = sinkIsDynamic ? dynamicNodes[sinkModule][ofToInt(sinkModuleId)] : persistentNodes[sinkModule][ofToInt(sinkModuleId)];
+        return nullptr;
+    };
+    ofxOceanodeNode *sourceModuleRef = findNode(sourceModule, ofToInt(sourceModuleId));
+    ofxOceanodeNode *sinkModuleRef = findNode(sinkModule, ofToInt(sinkModuleId));
     
     if(sourceModuleRef == nullptr || sinkModuleRef == nullptr) return nullptr;
     
@@ -942,7 +1675,7 @@ ofxOceanodeAbstractConnection* ofxOceanodeContainer::createConnectionFromInfo(st
         ofAbstractParameter &source = sourceModuleRef->getParameters()->get(sourceParameter);
         ofAbstractParameter &sink = sinkModuleRef->getParameters()->get(sinkParameter);
         
-        temporalConnectionNode = sourceModuleRef.get();
+        temporalConnectionNode = sourceModuleRef;
         auto connection = sinkModuleRef->createConnection(*this, source, sink);
         if(!isHeadless){
             connection->setSinkPosition(sinkModuleRef->getNodeGui().getSinkConnectionPositionFromParameter(sink));
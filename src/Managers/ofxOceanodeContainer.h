@@ -10,22 +10,29 @@
 #define ofxOceanodeContainer_h
 
 #include "ofxOceanodeConnection.h"
+#include "ofxOceanodeConnectionSlotMap.h"
 #include "ofxOceanodeNode.h"
 #include "ofxOceanodeNodeGui.h"
 
 class ofxOceanodeNodeModel;
 class ofxOceanodeNodeRegistry;
 class ofxOceanodeTypesRegistry;
+class ofxOceanodeEngine;
+class ofxOceanodeThreadPool;
+class ofxOceanodeClock;
 
 #ifdef OFXOCEANODE_USE_OSC
-#include "ofxOsc.h"
+#include "ofxOceanodeOscReceiver.h"
 #endif
 
 #ifdef OFXOCEANODE_USE_MIDI
+#include "ofxOceanodeMidiClock.h"
 class ofxOceanodeAbstractMidiBinding;
 class ofxMidiIn;
 class ofxMidiOut;
 class ofxMidiListener;
+class ofxMidiMessage;
+class ofxOceanodeMidiPortListener;
 #endif
 
 
@@ -64,18 +71,21 @@ public:
     
     template<typename Tsource, typename Tsink>
     ofxOceanodeAbstractConnection* connectConnection(ofParameter<Tsource>& source, ofParameter<Tsink>& sink){
-        connections.push_back(make_pair(temporalConnectionNode, make_shared<ofxOceanodeConnection<Tsource, Tsink>>(source, sink)));
-        temporalConnectionNode->addOutputConnection(connections.back().second.get());
+        auto connection = make_shared<ofxOceanodeConnection<Tsource, Tsink>>(source, sink);
+        connections.insert(connection);
+        temporalConnectionNode->addOutputConnection(connection.get());
+        scheduleDirty = true;
         if(!isHeadless){
-            connections.back().second->setSourcePosition(temporalConnectionNode->getNodeGui().getSourceConnectionPositionFromParameter(source));
-            connections.back().second->getGraphics().subscribeToDrawEvent(window);
+            connection->setSourcePosition(temporalConnectionNode->getNodeGui().getSourceConnectionPositionFromParameter(source));
+            connection->getGraphics().subscribeToDrawEvent(window);
         }
-        return connections.back().second.get();
+        return connection.get();
     }
     ofxOceanodeAbstractConnection* createConnectionFromInfo(string sourceModule, string sourceParameter, string sinkModule, string sinkParameter);
     ofxOceanodeAbstractConnection* createConnectionFromCustomType(ofAbstractParameter &source, ofAbstractParameter &sink);
     
     ofxOceanodeNodeRegistry & getRegistry(){return *registry;};
+    ofxOceanodeTypesRegistry & getTypesRegistry(){return *typesRegistry;};
     
     bool loadPreset(string presetFolderPath);
     void savePreset(string presetFolderPath);
@@ -87,16 +97,57 @@ public:
     void setBpm(float _bpm);
     void setPhase(float _phase);
     void resetPhase();
+    void resetPhaseAt(double time); //Time in the ofxOceanodeClock timebase
     
     void collapseGuis();
     void expandGuis();
     
+    //Engine: by default the graph is ticked on the window update, when threaded it ticks on its own thread at "rate" Hz
+    void setEngineThreaded(bool threaded, float rate = 1000);
+    bool getEngineThreaded(){return engine != nullptr;};
+    void setEngineRate(float rate);
+    float getEngineRate(){return engineRate;};
+    //Independent parts of the graph (not connected between them) are ticked in parallel when threads > 1
+    void setEngineThreads(int threads);
+    int getEngineThreads(){return engineThreads;};
+    //Deterministic ticks every part serially in schedule order, same results as a single thread
+    void setEngineDeterministic(bool deterministic);
+    bool getEngineDeterministic(){return engineDeterministic;};
+    //Lock to touch nodes or parameters from outside the engine tick or the update and input events of the gui windows (draw included)
+    std::unique_lock<std::recursive_timed_mutex> lockEngine(){return std::unique_lock<std::recursive_timed_mutex>(engineMutex);};
+    //Update, mouse and key events of a registered window don't run concurrently with the engine tick, they are
+    //where the gui writes. Draw runs while the engine ticks: node guis draw a copy of the values taken on update,
+    //node models draw with the engine locked
+    void registerGuiWindow(shared_ptr<ofAppBaseWindow> w);
+    //The phasors of the container nodes advance on the container clock thread at "rate" Hz,
+    //other containers keep their own clock and rate
+    void setClockRate(float rate);
+    float getClockRate();
+    
+    void update(ofEventArgs &args);
+    
     ofEvent<string> loadPresetEvent;
     
 #ifdef OFXOCEANODE_USE_OSC
     void setupOscSender(string host, int port);
     void setupOscReceiver(int port);
-    void update(ofEventArgs &args);
+    //Only apply the last message received for each parameter address in a tick, void parameters still get every trigger
+    void setOscCoalescing(bool b){oscCoalescing = b;};
+    bool getOscCoalescing(){return oscCoalescing;};
+    //Output parameters sent to the osc sender as "/Node_Name_1/Parameter", all of them in one bundle per tick.
+    //Values are sent as they are (not normalized). Vectors and buffers are sent as one blob of packed float32
+    //values in the byte order of the host, no conversion is done, the layout vector parameters read from OSC blobs.
+    //Outputs of nodes that don't exist are kept and sent once the node is created.
+    bool addOscOutput(ofAbstractParameter &p);
+    bool addOscOutput(string address);
+    void removeOscOutput(ofAbstractParameter &p);
+    void removeOscOutput(string address);
+    //Max bundles per second, 0 sends one every tick
+    void setOscOutputRate(float rate);
+    float getOscOutputRate(){return oscOutputRate;};
+    //Only send the parameters that changed since they were last sent
+    void setOscOutputChangesOnly(bool b);
+    bool getOscOutputChangesOnly(){return oscOutputChangesOnly;};
 #endif
     
 #ifdef OFXOCEANODE_USE_MIDI
@@ -107,22 +158,61 @@ public:
     ofEvent<ofxOceanodeAbstractMidiBinding> midiBindingCreated;
     ofEvent<ofxOceanodeAbstractMidiBinding> midiBindingDestroyed;
     vector<string> getMidiDevices(){return midiInPortList;};
+    //Listeners get the messages of every port on the engine tick, like the bindings
     void addNewMidiMessageListener(ofxMidiListener* listener);
+    //Arrival time (seconds of the steady clock) of the message being dispatched, for the listeners
+    double getMidiMessageTime(){return midiMessageTime;};
+    //Messages lost by the input ports because the engine didn't drain their queues in time
+    uint64_t getMidiDroppedMessages();
+    //Each bound parameter sends at most "rate" messages per second, only its last value
+    void setMidiOutputRate(float rate){midiOutputRate = rate;};
+    float getMidiOutputRate(){return midiOutputRate;};
+    //Don't send a control again if its 7 bit value didn't change
+    void setMidiOutputChangesOnly(bool b){midiOutputChangesOnly = b;};
+    bool getMidiOutputChangesOnly(){return midiOutputChangesOnly;};
+    //Follow the midi clock of a port, its tempo drives the bpm, its beat position the phase and the first pulse
+    //after start resets the phase. An empty port stops following, a port that doesn't exist is created as a virtual port.
+    void setMidiClockPort(string port);
+    string getMidiClockPort(){return midiClockPort;};
+    ofxOceanodeMidiClock &getMidiClock(){return midiClock;};
+    //Messages of the clock port go through here, it can also be fed a recorded clock stream. Time in the ofxOceanodeClock timebase
+    void receiveMidiClockMessage(ofxMidiMessage &message, double time);
 #endif
     
     ofParameter<glm::mat4> &getTransformationMatrix(){return transformationMatrix;};
     
 private:
     void temporalConnectionDestructor();
+    void destroyConnections(const vector<ofxOceanodeAbstractConnection*> &connectionsToBeDeleted);
+    void destroyNonPersistentConnections();
+    
+    void tick(ofEventArgs &args);
+    void compileSchedule();
+    //Graph changes asked by a node while the graph ticks in parallel are done after the barrier, returns false
+    //when there's no parallel tick running and the change has to be done now
+    bool deferGraphChange(std::function<void()> change);
+    void applyDeferredGraphChanges();
+    void lockGui();
+    void unlockGui();
     
     //NodeModel;
     std::unordered_map<string, nodeContainerWithId> dynamicNodes;
     std::unordered_map<string, nodeContainerWithId> persistentNodes;
+    
+    //Lowest free identifier of each node type, shared by dynamic and persistent nodes
+    struct nodeIdAllocator{
+        std::set<int> freeIds;
+        int nextId = 1;
+        int allocate();
+        void reserve(int id);
+        void release(int id);
+    };
+    std::unordered_map<string, nodeIdAllocator> nodeIds;
 
     string temporalConnectionTypeName;
     ofxOceanodeNode* temporalConnectionNode;
     ofxOceanodeTemporalConnection*   temporalConnection;
-    vector<pair<ofxOceanodeNode*, shared_ptr<ofxOceanodeAbstractConnection>>> connections;
+    ofxOceanodeConnectionSlotMap connections;
     std::shared_ptr<ofxOceanodeNodeRegistry>   registry;
     std::shared_ptr<ofxOceanodeTypesRegistry>   typesRegistry;
     
@@ -132,6 +222,26 @@ private:
     
     ofEventListener updateListener;
     
+    std::recursive_timed_mutex engineMutex;
+    std::unique_lock<std::recursive_timed_mutex> guiLock;
+    unique_ptr<ofxOceanodeEngine> engine;
+    ofEventListener engineListener;
+    ofEventListeners guiWindowListeners;
+    float engineRate;
+    vector<ofxOceanodeNode*> schedule;
+    std::atomic<bool> scheduleDirty;
+    std::atomic<uint64_t> nodesVersion; //Changes every time a node is created, deleted or changes its parameters, from any thread
+    unique_ptr<ofxOceanodeThreadPool> threadPool;
+    shared_ptr<ofxOceanodeClock> clock;
+    int engineThreads;
+    bool engineDeterministic;
+    vector<vector<ofxOceanodeNode*>> scheduleGroups;
+    vector<std::function<void()>> scheduleTasks;
+    ofEventArgs *tickArgs;
+    std::atomic<bool> parallelTickRunning;
+    vector<std::function<void()>> deferredGraphChanges;
+    std::mutex deferredGraphChangesMutex;
+    
     shared_ptr<ofAppBaseWindow> window;
     
     ofParameter<glm::mat4> transformationMatrix;
@@ -142,8 +252,41 @@ private:
     bool collapseAll;
     
 #ifdef OFXOCEANODE_USE_OSC
+    //Converters from OSC messages to parameters are registered by type in ofxOceanodeTypesRegistry
+    using oscSetter = void(*)(ofAbstractParameter &absParam, ofxOscMessage &m);
+    void rebuildOscRoutes();
+    void receiveOscMessages();
+    void processOscCommands();
+    void resolveOscOutputs();
+    void sendOscOutputs();
+    
+    struct oscOutput{
+        string address;
+        ofAbstractParameter *parameter = nullptr; //nullptr while the node doesn't exist
+        int type = -1;
+        string lastPayload;
+        bool sent = false;
+    };
+    static bool encodeOscOutput(const oscOutput &output, string &payload);
+    static void addOscOutputArgs(const oscOutput &output, const string &payload, ofxOscMessage &m);
+    
     ofxOscSender oscSender;
-    ofxOscReceiver oscReceiver;
+    bool oscSenderReady = false;
+    ofxOceanodeOscReceiver oscReceiver;
+    //Full OSC address ("/Node_Name_1/Parameter" or "/Global/Parameter") to the parameters it sets
+    std::unordered_map<string, vector<pair<ofAbstractParameter*, oscSetter>>> oscRoutes;
+    uint64_t oscRoutesVersion = 0;
+    bool oscCoalescing = true;
+    vector<pair<decltype(oscRoutes)::iterator, ofxOscMessage>> oscTickMessages;
+    std::unordered_map<const string*, size_t> oscTickMessageIndex;
+    //Messages that are not parameters (presets, bpm...) are handled on the main thread, protected by engineMutex
+    vector<ofxOscMessage> oscCommands;
+    vector<oscOutput> oscOutputs;
+    uint64_t oscOutputsVersion = 0;
+    float oscOutputRate = 60;
+    bool oscOutputChangesOnly = true;
+    std::chrono::steady_clock::time_point lastOscOutputTime;
+    string oscOutputPayload;
 #endif
     
 #ifdef OFXOCEANODE_USE_MIDI
@@ -159,6 +302,49 @@ private:
     ofEventListeners midiUnregisterlisteners;
     ofEventListeners midiSenderListeners;
     void midiBindingBound(const void * sender, string &portName);
+    
+    //Messages are queued by the midi thread and dispatched at the start of the tick,
+    //straight to the bindings of its (port, channel, status, control)
+    void receiveMidiMessages();
+    void dispatchMidiMessage(int port, ofxMidiMessage &message, double time);
+    void rebuildMidiDispatch();
+    static uint64_t midiDispatchKey(int port, int channel, int status, int control){
+        return (uint64_t(port) << 24) | (uint64_t(channel) << 16) | (uint64_t(status) << 8) | uint64_t(control);
+    };
+    vector<unique_ptr<ofxOceanodeMidiPortListener>> midiPortListeners;
+    std::unordered_map<uint64_t, vector<ofxOceanodeAbstractMidiBinding*>> midiDispatchTable;
+    vector<vector<ofxOceanodeAbstractMidiBinding*>> midiPortBindings; //Bindings that want every message of a port
+    vector<ofxOceanodeAbstractMidiBinding*> midiLearningBindings; //Bindings that want every message of every port
+    vector<ofxMidiListener*> midiMessageListeners;
+    double midiMessageTime = 0;
+    std::atomic<bool> midiDispatchDirty;
+    std::recursive_mutex midiDispatchMutex;
+    
+    struct midiOutput{
+        ofxOceanodeAbstractMidiBinding *binding = nullptr;
+        int port = 0; //Index in midiOutPortList
+        int status = 0;
+        int channel = 0;
+        int control = 0;
+        int value = 0;
+        int sentValue = -1;
+        bool pending = false;
+        std::chrono::steady_clock::time_point lastSentTime;
+    };
+    void queueMidiOutput(ofxOceanodeAbstractMidiBinding *binding, int port, ofxMidiMessage &message, bool isTrigger);
+    void dropMidiOutputs(ofxOceanodeAbstractMidiBinding *binding);
+    void sendMidiOutput(const midiOutput &output);
+    void sendMidiOutputs();
+    std::unordered_map<ofxOceanodeAbstractMidiBinding*, midiOutput> midiOutputs; //Last value of each binding
+    vector<midiOutput> midiOutputTriggers;
+    std::mutex midiOutputMutex;
+    float midiOutputRate = 60;
+    bool midiOutputChangesOnly = true;
+    
+    void openMidiInPort(string port, bool isVirtual = false);
+    ofxOceanodeMidiClock midiClock;
+    string midiClockPort;
+    int midiClockPortIndex = -1;
 #endif
     
 };
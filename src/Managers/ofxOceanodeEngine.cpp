@@ -0,0 +1,40 @@
+//
+//  ofxOceanodeEngine.cpp
+//  ofxOceanode
+//
+
+#include "ofxOceanodeEngine.h"
+
+ofxOceanodeEngine::ofxOceanodeEngine(std::recursive_timed_mutex &_engineMutex, float _rate) : engineMutex(_engineMutex){
+    rate = ofClamp(_rate, 1, 10000);
+    timerRate = rate;
+    timer.setPeriodicEvent(uint64_t(1000000000.0 / timerRate));
+    startThread();
+}
+
+ofxOceanodeEngine::~ofxOceanodeEngine(){
+    stopThread();
+    waitForThread(true);
+}
+
+void ofxOceanodeEngine::setRate(float _rate){
+    rate = ofClamp(_rate, 1, 10000);
+}
+
+void ofxOceanodeEngine::threadedFunction(){
+    while(isThreadRunning()){
+        if(timerRate != rate){
+            timerRate = rate;
+            timer.setPeriodicEvent(uint64_t(1000000000.0 / timerRate));
+        }
+        timer.waitNext();
+
+        //Don't block forever on the mutex, the gui thread can be waiting for us to stop
+        std::unique_lock<std::recursive_timed_mutex> lock(engineMutex, std::defer_lock);
+        while(!lock.try_lock_for(std::chrono::milliseconds(10))){
+            if(!isThreadRunning()) return;
+        }
+        ofEventArgs args;
+        ofNotifyEvent(tickEvent, args);
+    }
+}
@@ -0,0 +1,32 @@
+//
+//  ofxOceanodeEngine.h
+//  ofxOceanode
+//
+
+#ifndef ofxOceanodeEngine_h
+#define ofxOceanodeEngine_h
+
+#include "ofMain.h"
+
+//Thread that ticks the node graph at a fixed control rate, decoupled from the window loop.
+//The tick is notified while holding the engine mutex, so whoever else touches the graph has to lock it too.
+class ofxOceanodeEngine : public ofThread{
+public:
+    ofxOceanodeEngine(std::recursive_timed_mutex &_engineMutex, float _rate = 1000);
+    ~ofxOceanodeEngine();
+
+    void setRate(float _rate);
+    float getRate(){return rate;};
+
+    ofEvent<ofEventArgs> tickEvent;
+
+private:
+    void threadedFunction() override;
+
+    ofTimer timer;
+    std::recursive_timed_mutex &engineMutex;
+    std::atomic<float> rate;
+    float timerRate;
+};
+
+#endif /* ofxOceanodeEngine_h */
@@ -41,6 +41,12 @@ void ofxOceanodeMidiBinding<pair<int, bool>>::newMidiMessage(ofxMidiMessage& mes
     }
 }
 
+template<>
+bool ofxOceanodeMidiBinding<pair<int, bool>>::dispatchByControl(){
+    //Notes from "control" upwards
+    return false;
+}
+
 template<>
 void ofxOceanodeMidiBinding<pair<int, bool>>::bindParameter(){
     listener = parameter.newListener([this](pair<int, bool> &f){
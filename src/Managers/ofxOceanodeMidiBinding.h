@@ -13,6 +13,7 @@
 #include "ofParameter.h"
 #include "ofJson.h"
 #include "ofxMidi.h"
+#include "ofxOceanodeBuffer.h"
 
 using namespace std;
 
@@ -26,6 +27,7 @@ public:
         value.set("Value", -1, 0, 127);
         portName = "";
         modifiyingParameter = false;
+        lastMessageTime = 0;
     };
     ~ofxOceanodeAbstractMidiBinding(){};
     
@@ -78,6 +80,17 @@ public:
     ofParameter<int> &getValue(){return value;};
     
     string getPortName(){return portName;};
+    MidiStatus getStatus(){return status;};
+    //Arrival time (seconds of the steady clock) of the last message dispatched to the binding,
+    //messages are applied on the engine tick but keep the time they reached the port
+    double getLastMessageTime(){return lastMessageTime;};
+    void setLastMessageTime(double time){lastMessageTime = time;};
+    //Still waiting for the first message to learn its port, channel and control
+    bool getIsListening(){return isListening;};
+    //False for bindings that accept a range of controls, they receive every message of their port
+    virtual bool dispatchByControl(){return true;};
+    //Output messages are triggers, every one of them is sent (not only the last value of the tick)
+    virtual bool isTrigger(){return false;};
     
     virtual ofxMidiMessage& sendMidiMessage(){};
     virtual void bindParameter(){};
@@ -98,6 +111,7 @@ protected:
     ofxMidiMessage firstMidiMessage;
     
     bool modifiyingParameter;
+    double lastMessageTime;
     ofEventListener listener;
 };
 
@@ -113,6 +127,7 @@ public:
     
     void newMidiMessage(ofxMidiMessage& message){};
     void bindParameter(){};
+    bool dispatchByControl(){return true;};
     
 private:
     ofParameter<T>& parameter;
@@ -314,6 +329,101 @@ private:
     ofParameter<T> max;
 };
 
+//Same as the vectors, the binding sets and sends a single value
+template<>
+class ofxOceanodeMidiBinding<ofxOceanodeBuffer> : public ofxOceanodeAbstractMidiBinding{
+public:
+    ofxOceanodeMidiBinding(ofParameter<ofxOceanodeBuffer>& _parameter) : parameter(_parameter), ofxOceanodeAbstractMidiBinding(){
+        name = parameter.getGroupHierarchyNames()[0] + "-|-" + parameter.getEscapedName();
+        min.set("Min", parameter.getMin()[0], parameter.getMin()[0], parameter.getMax()[0]);
+        max.set("Max", parameter.getMax()[0], parameter.getMin()[0], parameter.getMax()[0]);
+    }
+    
+    ~ofxOceanodeMidiBinding(){};
+    
+    void savePreset(ofJson &json){
+        ofxOceanodeAbstractMidiBinding::savePreset(json);
+        json["Min"] = min.get();
+        json["Max"] = max.get();
+    }
+    
+    void loadPreset(ofJson &json){
+        ofxOceanodeAbstractMidiBinding::loadPreset(json);
+        min.set(json["Min"]);
+        max.set(json["Max"]);
+    }
+    
+    void newMidiMessage(ofxMidiMessage& message){
+        if(message.status == MIDI_NOTE_OFF){
+            message.status = MIDI_NOTE_ON;
+            message.velocity = 0;
+        }
+        if(isListening) ofxOceanodeAbstractMidiBinding::newMidiMessage(message);
+        if(message.channel == channel && message.status == status){
+            bool validMessage = false;
+            switch(status){
+                case MIDI_CONTROL_CHANGE:
+                {
+                    if(message.control == control){
+                        value = message.value;
+                        validMessage = true;
+                    }
+                    break;
+                }
+                case MIDI_NOTE_ON:
+                {
+                    if(message.pitch == control){
+                        value = message.velocity;
+                        validMessage = true;
+                    }
+                    break;
+                }
+                default:
+                {
+                    ofLog() << "Midi Type " << ofxMidiMessage::getStatusString(message.status) << " not supported for parameter of type Buffer";
+                }
+            }
+            if(validMessage){
+                modifiyingParameter = true;
+                parameter.set(ofxOceanodeBuffer{ofMap(value, 1, 127, min, max, true)});
+                modifiyingParameter = false;
+            }
+        }
+    };
+    
+    void bindParameter(){
+        listener = parameter.newListener([this](ofxOceanodeBuffer &b){
+            if(!modifiyingParameter && b.size() == 1){
+                value = ofMap(b[0], min, max, 1, 127, true);
+                ofxMidiMessage message;
+                message.status = status;
+                message.channel = channel;
+                switch(status){
+                    case MIDI_CONTROL_CHANGE:
+                        message.control = control;
+                        message.value = value;
+                        break;
+                    case MIDI_NOTE_ON:
+                        message.pitch = control;
+                        message.velocity = value;
+                        break;
+                    default:
+                        ofLog() << "Midi Type " << ofxMidiMessage::getStatusString(message.status) << " not supported for parameter of type Buffer";
+                }
+                midiMessageSender.notify(this, message);
+            }
+        });
+    };
+    
+    ofParameter<float> &getMinParameter(){return min;};
+    ofParameter<float> &getMaxParameter(){return max;};
+    
+private:
+    ofParameter<ofxOceanodeBuffer>& parameter;
+    ofParameter<float> min;
+    ofParameter<float> max;
+};
+
 template<>
 class ofxOceanodeMidiBinding<bool>: public ofxOceanodeAbstractMidiBinding{
 public:
@@ -509,12 +619,18 @@ public:
     };
     
     ofParameter<int> &getModeParameter(){return mode;};
+    bool isTrigger(){return true;};
     
 private:
     ofParameter<void>& parameter;
     ofParameter<int> mode;
 };
 
+//Defined in ofxOceanodeMidiBinding.cpp
+template<> void ofxOceanodeMidiBinding<pair<int, bool>>::newMidiMessage(ofxMidiMessage& message);
+template<> void ofxOceanodeMidiBinding<pair<int, bool>>::bindParameter();
+template<> bool ofxOceanodeMidiBinding<pair<int, bool>>::dispatchByControl();
+
 #endif
 
 #endif /* ofxOceanodeMidiBinding_h */
@@ -0,0 +1,104 @@
+//
+//  ofxOceanodeMidiClock.cpp
+//  ofxOceanode
+//
+
+#ifdef OFXOCEANODE_USE_MIDI
+
+#include "ofxOceanodeMidiClock.h"
+#include <cmath>
+#include <algorithm>
+
+ofxOceanodeMidiClock::ofxOceanodeMidiClock(double _bandwidth) : bandwidth(_bandwidth){
+    period = 60.0 / (120.0 * pulsesPerQuarter);
+    currentPulseTime = 0;
+    nextPulseTime = 0;
+    hasPulse = false;
+    pulsesSinceLock = 0;
+    running = false;
+    waitingFirstPulse = false;
+    startPending = false;
+    pulses = 0;
+}
+
+void ofxOceanodeMidiClock::resetLoop(double time){
+    currentPulseTime = time;
+    nextPulseTime = time + period;
+    hasPulse = true;
+    pulsesSinceLock = 0;
+}
+
+bool ofxOceanodeMidiClock::clock(double time){
+    if(!hasPulse){
+        resetLoop(time);
+    }else{
+        double interval = time - currentPulseTime;
+        //The clock was interrupted or jumped, start locking again from this pulse
+        if(interval <= 0 || interval > period * 8){
+            if(interval > 0 && interval < 1) period = interval;
+            resetLoop(time);
+        }else if(pulsesSinceLock < pulsesPerQuarter){
+            //While locking average the intervals, it converges much faster than the loop
+            period += (interval - period) / (pulsesSinceLock + 1);
+            currentPulseTime = time;
+            nextPulseTime = time + period;
+        }else{
+            double error = time - nextPulseTime;
+            double omega = 2.0 * 3.14159265358979323846 * bandwidth * period;
+            currentPulseTime = nextPulseTime;
+            nextPulseTime += std::sqrt(2.0) * omega * error + period;
+            period += omega * omega * error;
+        }
+        pulsesSinceLock++;
+    }
+    
+    bool songStarts = false;
+    if(running){
+        if(waitingFirstPulse){
+            waitingFirstPulse = false;
+            songStarts = startPending;
+            startPending = false;
+        }else{
+            pulses++;
+        }
+    }
+    return songStarts;
+}
+
+void ofxOceanodeMidiClock::start(double time){
+    running = true;
+    waitingFirstPulse = true;
+    startPending = true;
+    pulses = 0;
+}
+
+void ofxOceanodeMidiClock::continuePlaying(double time){
+    running = true;
+    waitingFirstPulse = true;
+    startPending = false;
+}
+
+void ofxOceanodeMidiClock::stop(){
+    running = false;
+    startPending = false;
+}
+
+void ofxOceanodeMidiClock::songPosition(int sixteenths){
+    //A sixteenth is 6 pulses
+    pulses = (long long)sixteenths * 6;
+    waitingFirstPulse = true;
+}
+
+double ofxOceanodeMidiClock::getBpm(){
+    return 60.0 / (period * pulsesPerQuarter);
+}
+
+double ofxOceanodeMidiClock::getBeatPosition(double time){
+    double position = (double)pulses;
+    if(running && !waitingFirstPulse && hasPulse){
+        position += std::min(std::max((time - currentPulseTime) / period, 0.0), 1.0);
+    }
+    return position / pulsesPerQuarter;
+}
+
+#endif
@@ -0,0 +1,61 @@
+//
+//  ofxOceanodeMidiClock.h
+//  ofxOceanode
+//
+
+#ifndef ofxOceanodeMidiClock_h
+#define ofxOceanodeMidiClock_h
+
+#ifdef OFXOCEANODE_USE_MIDI
+
+//Follows an incoming MIDI clock (24 pulses per quarter note, start, continue, stop, song position).
+//The pulse times go through a second order PLL (delay locked loop) that filters the jitter of the
+//midi driver, so the tempo and beat position are smooth. Times are seconds from any monotonic origin,
+//it doesn't depend on any midi port so it can be fed from a recorded clock stream.
+class ofxOceanodeMidiClock{
+public:
+    ofxOceanodeMidiClock(double bandwidth = 0.2);
+    
+    //Returns true on the first pulse after start, the song starts at that pulse
+    bool clock(double time);
+    //The song starts on the next pulse
+    void start(double time);
+    void continuePlaying(double time);
+    void stop();
+    //Song position pointer, in sixteenth notes
+    void songPosition(int sixteenths);
+    
+    //Loop bandwidth in Hz, lower filters more jitter but follows tempo changes slower
+    void setBandwidth(double hz){bandwidth = hz;};
+    double getBandwidth(){return bandwidth;};
+    
+    bool isRunning(){return running;};
+    //After start, continue or song position the position holds until the next pulse
+    bool isWaitingFirstPulse(){return waitingFirstPulse;};
+    //Enough pulses have been received to trust the tempo
+    bool isLocked(){return pulsesSinceLock >= pulsesPerQuarter;};
+    double getBpm();
+    //Quarter notes since the song start, interpolated between pulses
+    double getBeatPosition(double time);
+    
+    static constexpr int pulsesPerQuarter = 24;
+    
+private:
+    void resetLoop(double time);
+    
+    double bandwidth;
+    double period; //Filtered time between pulses
+    double currentPulseTime; //Filtered time of the last pulse
+    double nextPulseTime; //Predicted time of the next pulse
+    bool hasPulse;
+    int pulsesSinceLock;
+    
+    bool running;
+    bool waitingFirstPulse;
+    bool startPending;
+    long long pulses; //Pulses since the song start
+};
+
+#endif
+
+#endif /* ofxOceanodeMidiClock_h */
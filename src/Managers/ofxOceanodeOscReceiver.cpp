@@ -0,0 +1,21 @@
+//
+//  ofxOceanodeOscReceiver.cpp
+//  ofxOceanode
+//
+
+#ifdef OFXOCEANODE_USE_OSC
+
+#include "ofxOceanodeOscReceiver.h"
+
+void ofxOceanodeOscReceiver::ProcessMessage(const osc::ReceivedMessage &m, const osc::IpEndpointName &remoteEndpoint){
+    //The base class converts the message to ofxOscMessage, move it to our queue right away from the receive thread
+    ofxOscReceiver::ProcessMessage(m, remoteEndpoint);
+    ofxOscMessage message;
+    while(ofxOscReceiver::getNextMessage(message)){
+        if(!queue.push(message)){
+            droppedMessages++;
+        }
+    }
+}
+
+#endif
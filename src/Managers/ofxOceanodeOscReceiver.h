@@ -0,0 +1,36 @@
+//
+//  ofxOceanodeOscReceiver.h
+//  ofxOceanode
+//
+
+#ifndef ofxOceanodeOscReceiver_h
+#define ofxOceanodeOscReceiver_h
+
+#ifdef OFXOCEANODE_USE_OSC
+
+#include "ofxOsc.h"
+#include "ofxOceanodeSPSCQueue.h"
+
+//ofxOscReceiver that hands the messages from its receive thread to the engine through a lock-free queue,
+//so they are not held until the window update.
+class ofxOceanodeOscReceiver : public ofxOscReceiver{
+public:
+    ofxOceanodeOscReceiver(size_t queueSize = 8192) : queue(queueSize){
+        droppedMessages = 0;
+    };
+
+    bool popMessage(ofxOscMessage &m){return queue.pop(m);};
+    //Messages lost because the engine didn't drain the queue fast enough
+    uint64_t getDroppedMessages(){return droppedMessages;};
+
+protected:
+    void ProcessMessage(const osc::ReceivedMessage &m, const osc::IpEndpointName &remoteEndpoint) override;
+
+private:
+    ofxOceanodeSPSCQueue<ofxOscMessage> queue;
+    std::atomic<uint64_t> droppedMessages;
+};
+
+#endif
+
+#endif /* ofxOceanodeOscReceiver_h */
@@ -0,0 +1,61 @@
+//
+//  ofxOceanodeSPSCQueue.h
+//  ofxOceanode
+//
+
+#ifndef ofxOceanodeSPSCQueue_h
+#define ofxOceanodeSPSCQueue_h
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+//Bounded lock-free queue for one producer thread and one consumer thread (e.g. a receive thread and the engine).
+//push fails when the queue is full instead of blocking the producer.
+template<typename T>
+class ofxOceanodeSPSCQueue{
+public:
+    ofxOceanodeSPSCQueue(size_t capacity = 4096) : slots(capacity + 1){
+        head = 0;
+        tail = 0;
+    }
+
+    bool push(const T &value){
+        size_t currentHead = head.load(std::memory_order_relaxed);
+        size_t nextHead = increment(currentHead);
+        if(nextHead == tail.load(std::memory_order_acquire)) return false;
+        slots[currentHead] = value;
+        head.store(nextHead, std::memory_order_release);
+        return true;
+    }
+
+    bool pop(T &value){
+        size_t currentTail = tail.load(std::memory_order_relaxed);
+        if(currentTail == head.load(std::memory_order_acquire)) return false;
+        value = std::move(slots[currentTail]);
+        tail.store(increment(currentTail), std::memory_order_release);
+        return true;
+    }
+
+    //Next value to pop without removing it, nullptr when empty. Only for the consumer thread.
+    T* front(){
+        size_t currentTail = tail.load(std::memory_order_relaxed);
+        if(currentTail == head.load(std::memory_order_acquire)) return nullptr;
+        return &slots[currentTail];
+    }
+
+    bool empty() const{
+        return tail.load(std::memory_order_acquire) == head.load(std::memory_order_acquire);
+    }
+
+private:
+    size_t increment(size_t i) const{
+        return (i + 1) == slots.size() ? 0 : i + 1;
+    }
+
+    std::vector<T> slots;
+    alignas(64) std::atomic<size_t> head;
+    alignas(64) std::atomic<size_t> tail;
+};
+
+#endif /* ofxOceanodeSPSCQueue_h */
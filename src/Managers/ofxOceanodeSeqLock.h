@@ -0,0 +1,70 @@
+//
+//  ofxOceanodeSeqLock.h
+//  ofxOceanode
+//
+
+#ifndef ofxOceanodeSeqLock_h
+#define ofxOceanodeSeqLock_h
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+//Latest value cell for one writer thread and any number of readers. Readers never block the writer,
+//they retry if the value changed while they were copying it, and always get the last complete value.
+template<typename T>
+class ofxOceanodeSeqLock{
+    static_assert(std::is_trivially_copyable<T>::value, "ofxOceanodeSeqLock needs a trivially copyable type");
+public:
+    ofxOceanodeSeqLock(const T &initial = T()){
+        sequence = 0;
+        write(initial);
+        sequence = 0;
+    }
+    
+    void store(const T &value){
+        uint32_t s = sequence.load(std::memory_order_relaxed);
+        sequence.store(s + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        write(value);
+        sequence.store(s + 2, std::memory_order_release);
+    }
+    
+    T load() const{
+        T value;
+        uint32_t before, after;
+        do{
+            before = sequence.load(std::memory_order_acquire);
+            read(value);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            after = sequence.load(std::memory_order_relaxed);
+        }while((before & 1) || before != after);
+        return value;
+    }
+    
+private:
+    //The value is kept in atomic words so concurrent copies are well defined
+    static constexpr size_t numWords = (sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+    
+    void write(const T &value){
+        uint64_t buffer[numWords] = {};
+        memcpy(buffer, &value, sizeof(T));
+        for(size_t i = 0; i < numWords; i++){
+            words[i].store(buffer[i], std::memory_order_relaxed);
+        }
+    }
+    
+    void read(T &value) const{
+        uint64_t buffer[numWords];
+        for(size_t i = 0; i < numWords; i++){
+            buffer[i] = words[i].load(std::memory_order_relaxed);
+        }
+        memcpy(&value, buffer, sizeof(T));
+    }
+    
+    std::atomic<uint32_t> sequence;
+    std::atomic<uint64_t> words[numWords];
+};
+
+#endif /* ofxOceanodeSeqLock_h */
@@ -0,0 +1,97 @@
+//
+//  ofxOceanodeThreadPool.cpp
+//  ofxOceanode
+//
+
+#include "ofxOceanodeThreadPool.h"
+
+ofxOceanodeThreadPool::ofxOceanodeThreadPool(int numThreads){
+    numThreads = max(numThreads, 1);
+    remainingTasks = 0;
+    generation = 0;
+    exit = false;
+    for(int i = 0; i < numThreads; i++){
+        workers.push_back(make_unique<Worker>());
+    }
+    //Worker 0 is the thread that calls run
+    for(int i = 1; i < numThreads; i++){
+        threads.emplace_back(&ofxOceanodeThreadPool::workerLoop, this, i);
+    }
+}
+
+ofxOceanodeThreadPool::~ofxOceanodeThreadPool(){
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        exit = true;
+    }
+    wakeCondition.notify_all();
+    for(auto &t : threads){
+        t.join();
+    }
+}
+
+void ofxOceanodeThreadPool::run(vector<std::function<void()>> &tasks){
+    if(tasks.empty()) return;
+    if(workers.size() == 1 || tasks.size() == 1){
+        for(auto &task : tasks) task();
+        return;
+    }
+
+    remainingTasks = tasks.size();
+    for(int i = 0; i < tasks.size(); i++){
+        auto &worker = workers[i % workers.size()];
+        std::unique_lock<std::mutex> lock(worker->mutex);
+        worker->queue.push_back(&tasks[i]);
+    }
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        generation++;
+    }
+    wakeCondition.notify_all();
+
+    while(runNextTask(0));
+
+    std::unique_lock<std::mutex> lock(mutex);
+    doneCondition.wait(lock, [this](){return remainingTasks == 0;});
+}
+
+void ofxOceanodeThreadPool::workerLoop(int index){
+    uint64_t lastGeneration = 0;
+    while(true){
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wakeCondition.wait(lock, [this, lastGeneration](){return exit || generation != lastGeneration;});
+            if(exit) return;
+            lastGeneration = generation;
+        }
+        while(runNextTask(index));
+    }
+}
+
+bool ofxOceanodeThreadPool::runNextTask(int index){
+    std::function<void()>* task = nullptr;
+    {
+        auto &own = workers[index];
+        std::unique_lock<std::mutex> lock(own->mutex);
+        if(!own->queue.empty()){
+            task = own->queue.back();
+            own->queue.pop_back();
+        }
+    }
+    for(int i = 1; i < workers.size() && task == nullptr; i++){
+        auto &victim = workers[(index + i) % workers.size()];
+        std::unique_lock<std::mutex> lock(victim->mutex);
+        if(!victim->queue.empty()){
+            task = victim->queue.front();
+            victim->queue.pop_front();
+        }
+    }
+    if(task == nullptr) return false;
+
+    (*task)();
+    if(--remainingTasks == 0){
+        std::unique_lock<std::mutex> lock(mutex);
+        doneCondition.notify_all();
+    }
+    return true;
+}
@@ -0,0 +1,45 @@
+//
+//  ofxOceanodeThreadPool.h
+//  ofxOceanode
+//
+
+#ifndef ofxOceanodeThreadPool_h
+#define ofxOceanodeThreadPool_h
+
+#include "ofMain.h"
+#include <deque>
+
+//Work-stealing pool used by the container to run independent parts of the graph in parallel.
+//Each worker owns a queue, takes work from its back and steals from the front of the others when empty.
+class ofxOceanodeThreadPool{
+public:
+    //numThreads counts the calling thread, so numThreads - 1 workers are spawned
+    ofxOceanodeThreadPool(int numThreads);
+    ~ofxOceanodeThreadPool();
+
+    //Runs all the tasks and returns when all of them are finished (barrier), the calling thread works too
+    void run(vector<std::function<void()>> &tasks);
+
+    int getNumThreads(){return workers.size();};
+
+private:
+    struct Worker{
+        std::deque<std::function<void()>*> queue;
+        std::mutex mutex;
+    };
+
+    void workerLoop(int index);
+    bool runNextTask(int index);
+
+    vector<unique_ptr<Worker>> workers;
+    vector<std::thread> threads;
+
+    std::mutex mutex;
+    std::condition_variable wakeCondition;
+    std::condition_variable doneCondition;
+    std::atomic<int> remainingTasks;
+    uint64_t generation;
+    bool exit;
+};
+
+#endif /* ofxOceanodeThreadPool_h */
@@ -7,10 +7,298 @@
 
 #include "ofxOceanodeTypesRegistry.h"
 
-ofxOceanodeAbstractConnection* ofxOceanodeTypesRegistry::createCustomTypeConnection(ofxOceanodeContainer &container, ofAbstractParameter &source, ofAbstractParameter &sink){
-    for(auto functionForType : registryColector){
-        auto connection = functionForType(container, source, sink);
-        if(connection != nullptr) return connection;
+ofxOceanodeTypesRegistry::ofxOceanodeTypesRegistry(){
+    registerConnection<int, int>(OFXOCEANODE_TYPE_INT, OFXOCEANODE_TYPE_INT);
+    registerConnection<float, float>(OFXOCEANODE_TYPE_FLOAT, OFXOCEANODE_TYPE_FLOAT);
+    registerConnection<bool, bool>(OFXOCEANODE_TYPE_BOOL, OFXOCEANODE_TYPE_BOOL);
+    registerConnection<void, void>(OFXOCEANODE_TYPE_VOID, OFXOCEANODE_TYPE_VOID);
+    registerConnection<vector<float>, vector<float>>(OFXOCEANODE_TYPE_VECTOR_FLOAT, OFXOCEANODE_TYPE_VECTOR_FLOAT);
+    registerConnection<vector<int>, vector<int>>(OFXOCEANODE_TYPE_VECTOR_INT, OFXOCEANODE_TYPE_VECTOR_INT);
+    registerConnection<short int, short int>(OFXOCEANODE_TYPE_SHORT, OFXOCEANODE_TYPE_SHORT);
+    registerConnection<dropdown, dropdown>(OFXOCEANODE_TYPE_DROPDOWN, OFXOCEANODE_TYPE_DROPDOWN);
+    registerConnection<ofxOceanodeBuffer, ofxOceanodeBuffer>(OFXOCEANODE_TYPE_BUFFER, OFXOCEANODE_TYPE_BUFFER);
+
+    registerConnection<float, int>(OFXOCEANODE_TYPE_FLOAT, OFXOCEANODE_TYPE_INT);
+    registerConnection<float, vector<float>>(OFXOCEANODE_TYPE_FLOAT, OFXOCEANODE_TYPE_VECTOR_FLOAT);
+    registerConnection<float, vector<int>>(OFXOCEANODE_TYPE_FLOAT, OFXOCEANODE_TYPE_VECTOR_INT);
+    registerConnection<float, dropdown>(OFXOCEANODE_TYPE_FLOAT, OFXOCEANODE_TYPE_DROPDOWN);
+    registerConnection<float, bool>(OFXOCEANODE_TYPE_FLOAT, OFXOCEANODE_TYPE_BOOL);
+
+    registerConnection<int, float>(OFXOCEANODE_TYPE_INT, OFXOCEANODE_TYPE_FLOAT);
+    registerConnection<int, vector<float>>(OFXOCEANODE_TYPE_INT, OFXOCEANODE_TYPE_VECTOR_FLOAT);
+    registerConnection<int, vector<int>>(OFXOCEANODE_TYPE_INT, OFXOCEANODE_TYPE_VECTOR_INT);
+    registerConnection<int, dropdown>(OFXOCEANODE_TYPE_INT, OFXOCEANODE_TYPE_DROPDOWN);
+
+    registerConnection<vector<float>, float>(OFXOCEANODE_TYPE_VECTOR_FLOAT, OFXOCEANODE_TYPE_FLOAT);
+    registerConnection<vector<float>, int>(OFXOCEANODE_TYPE_VECTOR_FLOAT, OFXOCEANODE_TYPE_INT);
+    registerConnection<vector<float>, vector<int>>(OFXOCEANODE_TYPE_VECTOR_FLOAT, OFXOCEANODE_TYPE_VECTOR_INT);
+    registerConnection<vector<float>, dropdown>(OFXOCEANODE_TYPE_VECTOR_FLOAT, OFXOCEANODE_TYPE_DROPDOWN);
+
+    registerConnection<vector<int>, float>(OFXOCEANODE_TYPE_VECTOR_INT, OFXOCEANODE_TYPE_FLOAT);
+    registerConnection<vector<int>, int>(OFXOCEANODE_TYPE_VECTOR_INT, OFXOCEANODE_TYPE_INT);
+    registerConnection<vector<int>, vector<float>>(OFXOCEANODE_TYPE_VECTOR_INT, OFXOCEANODE_TYPE_VECTOR_FLOAT);
+    registerConnection<vector<int>, dropdown>(OFXOCEANODE_TYPE_VECTOR_INT, OFXOCEANODE_TYPE_DROPDOWN);
+
+    registerConnection<void, bool>(OFXOCEANODE_TYPE_VOID, OFXOCEANODE_TYPE_BOOL);
+    registerConnection<void, int>(OFXOCEANODE_TYPE_VOID, OFXOCEANODE_TYPE_INT);
+    registerConnection<void, float>(OFXOCEANODE_TYPE_VOID, OFXOCEANODE_TYPE_FLOAT);
+
+    registerConnection<dropdown, float>(OFXOCEANODE_TYPE_DROPDOWN, OFXOCEANODE_TYPE_FLOAT);
+    registerConnection<dropdown, int>(OFXOCEANODE_TYPE_DROPDOWN, OFXOCEANODE_TYPE_INT);
+    registerConnection<dropdown, vector<float>>(OFXOCEANODE_TYPE_DROPDOWN, OFXOCEANODE_TYPE_VECTOR_FLOAT);
+    registerConnection<dropdown, vector<int>>(OFXOCEANODE_TYPE_DROPDOWN, OFXOCEANODE_TYPE_VECTOR_INT);
+    registerConnection<dropdown, ofxOceanodeBuffer>(OFXOCEANODE_TYPE_DROPDOWN, OFXOCEANODE_TYPE_BUFFER);
+    
+    registerConnection<float, ofxOceanodeBuffer>(OFXOCEANODE_TYPE_FLOAT, OFXOCEANODE_TYPE_BUFFER);
+    registerConnection<int, ofxOceanodeBuffer>(OFXOCEANODE_TYPE_INT, OFXOCEANODE_TYPE_BUFFER);
+    registerConnection<vector<float>, ofxOceanodeBuffer>(OFXOCEANODE_TYPE_VECTOR_FLOAT, OFXOCEANODE_TYPE_BUFFER);
+    registerConnection<vector<int>, ofxOceanodeBuffer>(OFXOCEANODE_TYPE_VECTOR_INT, OFXOCEANODE_TYPE_BUFFER);
+    
+    registerConnection<ofxOceanodeBuffer, float>(OFXOCEANODE_TYPE_BUFFER, OFXOCEANODE_TYPE_FLOAT);
+    registerConnection<ofxOceanodeBuffer, int>(OFXOCEANODE_TYPE_BUFFER, OFXOCEANODE_TYPE_INT);
+    registerConnection<ofxOceanodeBuffer, vector<float>>(OFXOCEANODE_TYPE_BUFFER, OFXOCEANODE_TYPE_VECTOR_FLOAT);
+    registerConnection<ofxOceanodeBuffer, vector<int>>(OFXOCEANODE_TYPE_BUFFER, OFXOCEANODE_TYPE_VECTOR_INT);
+    registerConnection<ofxOceanodeBuffer, dropdown>(OFXOCEANODE_TYPE_BUFFER, OFXOCEANODE_TYPE_DROPDOWN);
+}
+
+ofxOceanodeAbstractConnection* ofxOceanodeTypesRegistry::createConnection(ofxOceanodeContainer &container, ofAbstractParameter &source, ofAbstractParameter &sink){
+    int sourceType = getTypeId(source);
+    int sinkType = getTypeId(sink);
+    if(sourceType < 0 || sinkType < 0 || sourceType >= connectionCreators.size() || sinkType >= connectionCreators.size()){
+        return nullptr;
     }
-    return nullptr;
+    auto &creator = connectionCreators[sourceType][sinkType];
+    if(!creator) return nullptr;
+    return creator(container, source, sink);
 }
+
+std::unordered_map<std::type_index, int>& ofxOceanodeTypesRegistry::getTypeIds(){
+    static std::unordered_map<std::type_index, int> typeIds = {
+        {typeid(ofParameter<float>), OFXOCEANODE_TYPE_FLOAT},
+        {typeid(ofParameter<int>), OFXOCEANODE_TYPE_INT},
+        {typeid(ofParameter<bool>), OFXOCEANODE_TYPE_BOOL},
+        {typeid(ofParameter<void>), OFXOCEANODE_TYPE_VOID},
+        {typeid(ofParameter<vector<float>>), OFXOCEANODE_TYPE_VECTOR_FLOAT},
+        {typeid(ofParameter<vector<int>>), OFXOCEANODE_TYPE_VECTOR_INT},
+        {typeid(ofParameter<short int>), OFXOCEANODE_TYPE_SHORT},
+        {typeid(ofParameter<string>), OFXOCEANODE_TYPE_STRING},
+        {typeid(ofParameter<ofColor>), OFXOCEANODE_TYPE_COLOR},
+        {typeid(ofParameter<pair<int, bool>>), OFXOCEANODE_TYPE_PAIR_INT_BOOL},
+        {typeid(ofParameterGroup), OFXOCEANODE_TYPE_DROPDOWN},
+        {typeid(ofParameter<ofxOceanodeBuffer>), OFXOCEANODE_TYPE_BUFFER}
+    };
+    return typeIds;
+}
+
+int ofxOceanodeTypesRegistry::allocateTypeId(const std::type_info &type){
+    auto &typeIds = getTypeIds();
+    auto it = typeIds.find(type);
+    if(it != typeIds.end()) return it->second;
+    int newId = typeIds.size();
+    typeIds[type] = newId;
+    return newId;
+}
+
+int ofxOceanodeTypesRegistry::getTypeId(const ofAbstractParameter &p){
+    auto &typeIds = getTypeIds();
+    auto it = typeIds.find(typeid(p));
+    if(it != typeIds.end()) return it->second;
+    return OFXOCEANODE_TYPE_UNKNOWN;
+}
+
+vector<ofxOceanodeTypesRegistry::typeSerializers>& ofxOceanodeTypesRegistry::getSerializers(){
+    static vector<typeSerializers> serializers = [](){
+        vector<typeSerializers> builtin(OFXOCEANODE_NUM_BUILTIN_TYPES);
+        typeSerializers plain = {
+            [](ofJson &json, ofAbstractParameter &p){ofSerialize(json, p);},
+            [](const ofJson &json, ofAbstractParameter &p){ofDeserialize(json, p);}
+        };
+        builtin[OFXOCEANODE_TYPE_FLOAT] = plain;
+        builtin[OFXOCEANODE_TYPE_INT] = plain;
+        builtin[OFXOCEANODE_TYPE_BOOL] = plain;
+        builtin[OFXOCEANODE_TYPE_COLOR] = plain;
+        builtin[OFXOCEANODE_TYPE_STRING] = plain;
+        //Vectors are only saved when they hold a single value
+        builtin[OFXOCEANODE_TYPE_VECTOR_FLOAT] = {
+            [](ofJson &json, ofAbstractParameter &p){
+                auto &vecF = p.cast<vector<float>>().get();
+                if(vecF.size() == 1){
+                    json[p.getEscapedName()] = vecF[0];
+                }
+            },
+            [](const ofJson &json, ofAbstractParameter &p){
+                auto &value = json[p.getEscapedName()];
+                if(value.is_string()){
+                    p.cast<vector<float>>() = vector<float>(1, ofToFloat(value));
+                }else{
+                    p.cast<vector<float>>() = vector<float>(1, float(value));
+                }
+            }
+        };
+        builtin[OFXOCEANODE_TYPE_BUFFER] = {
+            [](ofJson &json, ofAbstractParameter &p){
+                auto &buffer = p.cast<ofxOceanodeBuffer>().get();
+                if(buffer.size() == 1){
+                    json[p.getEscapedName()] = buffer[0];
+                }
+            },
+            [](const ofJson &json, ofAbstractParameter &p){
+                auto &value = json[p.getEscapedName()];
+                if(value.is_string()){
+                    p.cast<ofxOceanodeBuffer>() = ofxOceanodeBuffer{ofToFloat(value)};
+                }else{
+                    p.cast<ofxOceanodeBuffer>() = ofxOceanodeBuffer{float(value)};
+                }
+            }
+        };
+        builtin[OFXOCEANODE_TYPE_VECTOR_INT] = {
+            [](ofJson &json, ofAbstractParameter &p){
+                auto &vecI = p.cast<vector<int>>().get();
+                if(vecI.size() == 1){
+                    json[p.getEscapedName()] = vecI[0];
+                }
+            },
+            [](const ofJson &json, ofAbstractParameter &p){
+                auto &value = json[p.getEscapedName()];
+                if(value.is_string()){
+                    p.cast<vector<int>>() = vector<int>(1, ofToInt(value));
+                }else{
+                    p.cast<vector<int>>() = vector<int>(1, int(value));
+                }
+            }
+        };
+        builtin[OFXOCEANODE_TYPE_DROPDOWN] = {
+            [](ofJson &json, ofAbstractParameter &p){
+                json[p.getEscapedName()] = p.castGroup().getInt(1).toString();
+            },
+            [](const ofJson &json, ofAbstractParameter &p){
+                p.castGroup().getInt(1).fromString(json[p.getEscapedName()]);
+            }
+        };
+        return builtin;
+    }();
+    return serializers;
+}
+
+bool ofxOceanodeTypesRegistry::serializeParameter(ofJson &json, ofAbstractParameter &p){
+    int typeId = getTypeId(p);
+    auto &serializers = getSerializers();
+    if(typeId < 0 || typeId >= serializers.size() || !serializers[typeId].serialize) return false;
+    serializers[typeId].serialize(json, p);
+    return true;
+}
+
+bool ofxOceanodeTypesRegistry::deserializeParameter(const ofJson &json, ofAbstractParameter &p){
+    int typeId = getTypeId(p);
+    auto &serializers = getSerializers();
+    if(typeId < 0 || typeId >= serializers.size() || !serializers[typeId].deserialize) return false;
+    serializers[typeId].deserialize(json, p);
+    return true;
+}
+
+#ifdef OFXOCEANODE_USE_OSC
+
+bool ofxOceanodeTypesRegistry::readOscBlob(ofxOscMessage &m, float min, float max, vector<float> &values){
+    if(m.getNumArgs() == 0 || m.getArgType(0) != ofxOscArgType::OFXOSC_TYPE_BLOB) return false;
+    const ofBuffer &blob = m.getArgAsBlob(0);
+    if(m.getNumArgs() > 1 && m.getArgType(1) == ofxOscArgType::OFXOSC_TYPE_STRING && m.getArgAsString(1) == "u8"){
+        const uint8_t *bytes = reinterpret_cast<const uint8_t*>(blob.getData());
+        values.resize(blob.size());
+        float scale = (max - min) / 255.0f;
+        for(int i = 0; i < values.size(); i++){
+            values[i] = min + bytes[i] * scale;
+        }
+    }else{
+        //Raw values, the same the OSC outputs send, only clamped. NaN goes to min
+        values.resize(blob.size() / sizeof(float));
+        memcpy(values.data(), blob.getData(), values.size() * sizeof(float));
+        for(auto &v : values){
+            v = std::isnan(v) ? min : ofClamp(v, min, max);
+        }
+    }
+    return true;
+}
+
+vector<ofxOceanodeTypesRegistry::oscConverter>& ofxOceanodeTypesRegistry::getOscConverters(){
+    static vector<oscConverter> oscConverters = [](){
+        vector<oscConverter> converters(OFXOCEANODE_NUM_BUILTIN_TYPES, nullptr);
+        converters[OFXOCEANODE_TYPE_FLOAT] = [](ofAbstractParameter &absParam, ofxOscMessage &m){
+            ofParameter<float> &castedParam = absParam.cast<float>();
+            castedParam = ofMap(m.getArgAsFloat(0), 0, 1, castedParam.getMin(), castedParam.getMax(), true);
+        };
+        converters[OFXOCEANODE_TYPE_INT] = [](ofAbstractParameter &absParam, ofxOscMessage &m){
+            ofParameter<int> &castedParam = absParam.cast<int>();
+            castedParam = ofMap(m.getArgAsFloat(0), 0, 1, castedParam.getMin(), castedParam.getMax(), true);
+        };
+        converters[OFXOCEANODE_TYPE_BOOL] = [](ofAbstractParameter &absParam, ofxOscMessage &m){
+            absParam.cast<bool>() = m.getArgAsBool(0);
+        };
+        converters[OFXOCEANODE_TYPE_VOID] = [](ofAbstractParameter &absParam, ofxOscMessage &m){
+            absParam.cast<void>().trigger();
+        };
+        converters[OFXOCEANODE_TYPE_STRING] = [](ofAbstractParameter &absParam, ofxOscMessage &m){
+            absParam.cast<string>() = m.getArgAsString(0);
+        };
+        converters[OFXOCEANODE_TYPE_DROPDOWN] = [](ofAbstractParameter &absParam, ofxOscMessage &m){
+            absParam.castGroup().getInt(1) = m.getArgAsInt(0);
+        };
+        converters[OFXOCEANODE_TYPE_VECTOR_FLOAT] = [](ofAbstractParameter &absParam, ofxOscMessage &m){
+            ofParameter<vector<float>> &castedParam = absParam.cast<vector<float>>();
+            static thread_local vector<float> tempVec;
+            if(!readOscBlob(m, castedParam.getMin()[0], castedParam.getMax()[0], tempVec)){
+                tempVec.resize(m.getNumArgs(), 0);
+                for(int i = 0; i < tempVec.size(); i++){
+                    tempVec[i] = ofMap(m.getArgAsFloat(i), 0, 1, castedParam.getMin()[0], castedParam.getMax()[0], true);
+                }
+            }
+            castedParam = tempVec;
+        };
+        //Read into a new vector that the buffer takes
+        converters[OFXOCEANODE_TYPE_BUFFER] = [](ofAbstractParameter &absParam, ofxOscMessage &m){
+            ofParameter<ofxOceanodeBuffer> &castedParam = absParam.cast<ofxOceanodeBuffer>();
+            vector<float> values;
+            if(!readOscBlob(m, castedParam.getMin()[0], castedParam.getMax()[0], values)){
+                values.resize(m.getNumArgs(), 0);
+                for(int i = 0; i < values.size(); i++){
+                    values[i] = ofMap(m.getArgAsFloat(i), 0, 1, castedParam.getMin()[0], castedParam.getMax()[0], true);
+                }
+            }
+            castedParam = ofxOceanodeBuffer(std::move(values));
+        };
+        converters[OFXOCEANODE_TYPE_VECTOR_INT] = [](ofAbstractParameter &absParam, ofxOscMessage &m){
+            ofParameter<vector<int>> &castedParam = absParam.cast<vector<int>>();
+            static thread_local vector<float> blobVec;
+            static thread_local vector<int> tempVec;
+            if(readOscBlob(m, castedParam.getMin()[0], castedParam.getMax()[0], blobVec)){
+                tempVec.resize(blobVec.size());
+                for(int i = 0; i < tempVec.size(); i++){
+                    tempVec[i] = ofClamp(blobVec[i], castedParam.getMin()[0], castedParam.getMax()[0]);
+                }
+            }else{
+                tempVec.assign(m.getNumArgs(), 0);
+                if(m.getArgType(0) == ofxOscArgType::OFXOSC_TYPE_FLOAT){
+                    for(int i = 0; i < tempVec.size(); i++){
+                        tempVec[i] = ofMap(m.getArgAsFloat(i), 0, 1, castedParam.getMin()[0], castedParam.getMax()[0], true);
+                    }
+                }
+                else if(m.getArgType(0) == ofxOscArgType::OFXOSC_TYPE_INT32 || m.getArgType(0) == ofxOscArgType::OFXOSC_TYPE_INT64){
+                    for(int i = 0; i < tempVec.size(); i++){
+                        tempVec[i] = ofClamp(m.getArgAsInt(i), castedParam.getMin()[0], castedParam.getMax()[0]);
+                    }
+                }
+            }
+            castedParam = tempVec;
+        };
+        return converters;
+    }();
+    return oscConverters;
+}
+
+ofxOceanodeTypesRegistry::oscConverter ofxOceanodeTypesRegistry::getOscConverter(ofAbstractParameter &p){
+    int typeId = getTypeId(p);
+    auto &converters = getOscConverters();
+    if(typeId < 0 || typeId >= converters.size()) return nullptr;
+    return converters[typeId];
+}
+
+#endif
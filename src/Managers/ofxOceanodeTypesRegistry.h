@@ -9,31 +9,127 @@
 #define ofxOceanodeTypesRegistry_h
 
 #include "ofxOceanodeContainer.h"
+#include <typeindex>
+
+//Compact ids of the parameter types oceanode knows, custom types registered with registerType get the following ones
+enum ofxOceanodeParameterType{
+    OFXOCEANODE_TYPE_UNKNOWN = -1,
+    OFXOCEANODE_TYPE_FLOAT = 0,
+    OFXOCEANODE_TYPE_INT,
+    OFXOCEANODE_TYPE_BOOL,
+    OFXOCEANODE_TYPE_VOID,
+    OFXOCEANODE_TYPE_VECTOR_FLOAT,
+    OFXOCEANODE_TYPE_VECTOR_INT,
+    OFXOCEANODE_TYPE_SHORT,
+    OFXOCEANODE_TYPE_STRING,
+    OFXOCEANODE_TYPE_COLOR,
+    OFXOCEANODE_TYPE_PAIR_INT_BOOL,
+    OFXOCEANODE_TYPE_DROPDOWN, //ofParameterGroup with the options and the selector
+    OFXOCEANODE_TYPE_BUFFER, //ofxOceanodeBuffer, vector of floats shared between connections
+    OFXOCEANODE_NUM_BUILTIN_TYPES
+};
 
 class ofxOceanodeTypesRegistry{
 public:
     using registryCreator   = std::function<ofxOceanodeAbstractConnection*(ofxOceanodeContainer &container, ofAbstractParameter &source, ofAbstractParameter &sink)>;
-    
-    ofxOceanodeTypesRegistry(){};
+    using parameterSerializer = std::function<void(ofJson &json, ofAbstractParameter &p)>;
+    using parameterDeserializer = std::function<void(const ofJson &json, ofAbstractParameter &p)>;
+#ifdef OFXOCEANODE_USE_OSC
+    using oscConverter = void(*)(ofAbstractParameter &p, ofxOscMessage &m);
+#endif
+
+    ofxOceanodeTypesRegistry();
     ~ofxOceanodeTypesRegistry(){};
-    
+
     template<typename T>
     void registerType(){
+        int typeId = allocateTypeId(typeid(ofParameter<T>));
+        registerConnection<T, T>(typeId, typeId);
+    }
+
+    //Looks up the [source][sink] table, nullptr if the types can't be connected
+    ofxOceanodeAbstractConnection* createConnection(ofxOceanodeContainer &container, ofAbstractParameter &source, ofAbstractParameter &sink);
+    ofxOceanodeAbstractConnection* createCustomTypeConnection(ofxOceanodeContainer &container, ofAbstractParameter &source, ofAbstractParameter &sink){
+        return createConnection(container, source, sink);
+    };
+
+    static int getTypeId(const ofAbstractParameter &p);
+
+    //Type ids are process wide and so are the serializers and converters indexed by them,
+    //custom types have to register theirs before any container loads presets or receives OSC
+    template<typename T>
+    void registerSerializer(parameterSerializer serializer, parameterDeserializer deserializer){
+        int typeId = allocateTypeId(typeid(ofParameter<T>));
+        auto &serializers = getSerializers();
+        if(serializers.size() <= typeId) serializers.resize(typeId + 1);
+        serializers[typeId] = {serializer, deserializer};
+    }
+
+    //Preset serialization through the table, returns false for the types that are not saved
+    static bool serializeParameter(ofJson &json, ofAbstractParameter &p);
+    static bool deserializeParameter(const ofJson &json, ofAbstractParameter &p);
+
+#ifdef OFXOCEANODE_USE_OSC
+    template<typename T>
+    void registerOscConverter(oscConverter converter){
+        int typeId = allocateTypeId(typeid(ofParameter<T>));
+        auto &converters = getOscConverters();
+        if(converters.size() <= typeId) converters.resize(typeId + 1, nullptr);
+        converters[typeId] = converter;
+    }
+
+    //nullptr if the parameter can't be set from OSC
+    static oscConverter getOscConverter(ofAbstractParameter &p);
+    //Vector and buffer parameters also accept a single blob of packed float32 values in the byte order of the host
+    //(no conversion is done), the layout addOscOutput sends. The values are not normalized, they are clamped to min-max.
+    //A blob followed by the string "u8" holds one uint8 per value instead, mapped from 0-255 to min-max
+    static bool readOscBlob(ofxOscMessage &m, float min, float max, vector<float> &values);
+#endif
+
+private:
+    //Dropdowns are groups, the connection goes to the selector
+    struct dropdown{};
+
+    template<typename T>
+    struct parameterCast{
+        static ofParameter<T>& cast(ofAbstractParameter &p){return p.cast<T>();};
+    };
+
+    template<typename Tsource, typename Tsink>
+    void registerConnection(int sourceType, int sinkType){
         registryCreator creator = [](ofxOceanodeContainer &container, ofAbstractParameter &source, ofAbstractParameter &sink) -> ofxOceanodeAbstractConnection*
             {
-                if(source.type() == typeid(ofParameter<T>).name()){
-                    return container.connectConnection(source.cast<T>(), sink.cast<T>());
-                }
-                return nullptr;
+                return container.connectConnection(parameterCast<Tsource>::cast(source), parameterCast<Tsink>::cast(sink));
             };
-        
-        registryColector.push_back(std::move(creator));
+
+        int tableSize = max(sourceType, sinkType) + 1;
+        if(connectionCreators.size() < tableSize){
+            connectionCreators.resize(tableSize);
+        }
+        for(auto &row : connectionCreators){
+            if(row.size() < connectionCreators.size()) row.resize(connectionCreators.size());
+        }
+        connectionCreators[sourceType][sinkType] = std::move(creator);
     }
-    
-    ofxOceanodeAbstractConnection* createCustomTypeConnection(ofxOceanodeContainer &container, ofAbstractParameter &source, ofAbstractParameter &sink);
-    
-private:
-    vector<registryCreator> registryColector;
+
+    struct typeSerializers{
+        parameterSerializer serialize;
+        parameterDeserializer deserialize;
+    };
+
+    static std::unordered_map<std::type_index, int>& getTypeIds();
+    static int allocateTypeId(const std::type_info &type);
+    static vector<typeSerializers>& getSerializers();
+#ifdef OFXOCEANODE_USE_OSC
+    static vector<oscConverter>& getOscConverters();
+#endif
+
+    vector<vector<registryCreator>> connectionCreators;
+};
+
+template<>
+struct ofxOceanodeTypesRegistry::parameterCast<ofxOceanodeTypesRegistry::dropdown>{
+    static ofParameter<int>& cast(ofAbstractParameter &p){return p.castGroup().getInt(1);};
 };
 
 #endif /* ofxOceanodeTypesRegistry_h */
@@ -36,6 +36,12 @@ void ofxOceanodeNodeModelLocalPreset::presetListener(short int &preset){
                         json[p.getEscapedName()] = vecF[0];
                     }
                 }
+                else if(p.type() == typeid(ofParameter<ofxOceanodeBuffer>).name()){
+                    auto &buffer = p.cast<ofxOceanodeBuffer>().get();
+                    if(buffer.size() == 1){
+                        json[p.getEscapedName()] = buffer[0];
+                    }
+                }
                 else if(p.type() == typeid(ofParameter<vector<int>>).name()){
                     auto vecI = p.cast<vector<int>>().get();
                     if(vecI.size() == 1){
@@ -73,6 +79,10 @@ void ofxOceanodeNodeModelLocalPreset::presetListener(short int &preset){
                         float value = it.value();
                         p.cast<vector<float>>() = vector<float>(1, value);
                     }
+                    else if(p.type() == typeid(ofParameter<ofxOceanodeBuffer>).name()){
+                        float value = it.value();
+                        p.cast<ofxOceanodeBuffer>() = ofxOceanodeBuffer{value};
+                    }
                     else if(p.type() == typeid(ofParameter<vector<int>>).name()){
                         int value = it.value();
                         p.cast<vector<int>>() = vector<int>(1, value);
@@ -6,8 +6,6 @@
 //
 //
 
-#define _USE_MATH_DEFINES
-
 #include "baseOscillator.h"
 #include "ofMath.h"
 
@@ -15,14 +13,14 @@ baseOscillator::baseOscillator(){
     oldPhasor = 0;
     oldValuePreMod = 0;
     indexNormalized = 0;
-    pastRandom = ofRandom(1);
-    newRandom = ofRandom(1);
 #ifdef OFXOCEANODE_USE_RANDOMSEED
     seed = 0;
+#endif
     std::random_device rd;
     mt.seed(rd());
     dist = std::uniform_real_distribution<float>(0.0, 1.0);
-#endif
+    pastRandom = dist(mt);
+    newRandom = dist(mt);
 }
 
 #ifdef OFXOCEANODE_USE_RANDOMSEED
@@ -37,57 +35,37 @@ void baseOscillator::deactivateSeed(){
 #endif
 
 float baseOscillator::computeFunc(float phasor){
-    //get phasor to be w (radial freq)
-    float w = (phasor*2*M_PI);
-    
-    float k = (indexNormalized + phaseOffset_Param) * 2 * M_PI;
-//
-//    //invert it?
-//    k *=  freq_Param * ((float)indexCount_Param/(float)indexQuant_Param); //Index Modifiers
+    //Work in cycles (0..1) with float math, w is the phase of this oscillator
+    float w = phasor + indexNormalized + phaseOffset_Param;
+    w -= floorf(w);
     
-    w += k;
-    w = fmod(w, 2*M_PI);
+    //Pulse width, the wave runs in the last pulseWidth part of the cycle
+    w = (pulseWidth_Param > 0) ? ofClamp((w - (1 - pulseWidth_Param)) / pulseWidth_Param, 0.0f, 1.0f) : 0;
     
-    w = ofMap(w, (1-pulseWidth_Param)*2.0*M_PI, 2.0*M_PI, 0.0, 2.0*M_PI, true);
+    //Skew moves the middle of the cycle to breakpoint
+    float breakpoint = 0.5f - 0.5f * skew_Param;
+    if(w <= breakpoint)
+        w = (breakpoint > 0) ? w * 0.5f / breakpoint : 0;
+    else
+        w = (breakpoint < 1) ? 0.5f + (w - breakpoint) * 0.5f / (1 - breakpoint) : 0.5f;
     
-    float skewedW = w;
-    
-    
-    if(skew_Param < 0){
-        if(w < M_PI+((abs(skew_Param))*M_PI))
-            skewedW = ofMap(w, 0.0, M_PI+((abs(skew_Param))*M_PI), 0.0, M_PI, true);
-        else
-            skewedW = ofMap(w, M_PI+((abs(skew_Param))*M_PI), 2.0*M_PI, M_PI, 2.0*M_PI, true);
-    }
-    else if(skew_Param > 0){
-        if(w > ((1-abs(skew_Param))*M_PI))
-            skewedW = ofMap(w, (1-abs(skew_Param))*M_PI, 2.0*M_PI, M_PI, 2.0*M_PI, true);
-        else
-            skewedW = ofMap(w, 0, ((1-abs(skew_Param))*M_PI), 0.0, M_PI, true);
-    }
-    
-    w = skewedW;
-
-    
-    float linPhase =  w / (2*M_PI);
+    float linPhase = w;
     float val = 0;
     switch (static_cast<oscTypes>(waveSelect_Param+1)){
         case sinOsc:
         {
-            val = sin(w);
-            val = ofMap(val, -1.0, 1.0, 0.0, 1.0);
+            val = sinf(linPhase * (float)TWO_PI) * 0.5f + 0.5f;
             break;
             
         }
         case cosOsc:
         {
-            val = cos(w);
-            val = ofMap(val, -1.0, 1.0, 0.0, 1.0);
+            val = cosf(linPhase * (float)TWO_PI) * 0.5f + 0.5f;
             break;
         }
         case triOsc:
         {
-            val = 1-(fabs((linPhase * (-2)) + 1));
+            val = 1 - fabsf(1 - 2 * linPhase);
             break;
         }
         case squareOsc:
@@ -108,11 +86,7 @@ float baseOscillator::computeFunc(float phasor){
         case rand1Osc:
         {
             if(linPhase < oldPhasor){
-#ifdef OFXOCEANODE_USE_RANDOMSEED
                 val = dist(mt);
-#else
-                val = ofRandom(1);
-#endif
             }else
                 val = oldValuePreMod;
             
@@ -122,11 +96,7 @@ float baseOscillator::computeFunc(float phasor){
         {
             if(linPhase < oldPhasor){
                 pastRandom = newRandom;
-#ifdef OFXOCEANODE_USE_RANDOMSEED
                 newRandom = dist(mt);
-#else
-                newRandom = ofRandom(1);
-#endif
                 val = pastRandom;
             }
             else
@@ -151,9 +121,9 @@ void baseOscillator::computeMultiplyMod(float &value){
     
     //random Add
     if(randomAdd_Param)
-        value += randomAdd_Param*ofRandom(1);
+        value += randomAdd_Param*dist(mt);
     
-    value = ofClamp(value, 0.0, 1.0);
+    value = ofClamp(value, 0.0f, 1.0f);
     
     //SCALE
     value *= scale_Param;
@@ -161,35 +131,30 @@ void baseOscillator::computeMultiplyMod(float &value){
     //OFFSET
     value += offset_Param;
     
-    value = ofClamp(value, 0.0, 1.0);
+    value = ofClamp(value, 0.0f, 1.0f);
     
     //pow
     if(pow_Param != 0)
-        value = (pow_Param < 0) ? pow(value, 1/(float)(-pow_Param+1)) : pow(value, pow_Param+1);
+        value = powf(value, (pow_Param < 0) ? 1/(-pow_Param+1) : pow_Param+1);
     
     //bipow
     if(biPow_Param != 0){
-        value = ofMap(value, 0.0, 1.0, -1.0, 1.0);
-        if(value < 0)
-            value = -((biPow_Param < 0) ? pow(abs(value), 1/(float)(-biPow_Param+1)) : pow(abs(value), biPow_Param+1));
-        else
-            value = (biPow_Param < 0) ? pow(value, 1/(float)(-biPow_Param+1)) : pow(value, biPow_Param+1);
-        value = ofMap(value, -1.0, 1.0, 0.0, 1.0);
+        value = value * 2 - 1;
+        float exponent = (biPow_Param < 0) ? 1/(-biPow_Param+1) : biPow_Param+1;
+        value = (value < 0) ? -powf(-value, exponent) : powf(value, exponent);
+        value = (value + 1) * 0.5f;
     }
     
-    value = ofClamp(value, 0.0, 1.0);
+    value = ofClamp(value, 0.0f, 1.0f);
     
     //Quantization
     if(quant_Param < 255){
-        value = (1.0/((float)quant_Param-1))*float(floor(value*quant_Param));
+        value = floorf(value*quant_Param) / (quant_Param-1);
     }
     
-    value = ofClamp(value, 0.0, 1.0);
+    value = ofClamp(value, 0.0f, 1.0f);
     
     value *= amplitude_Param;
     
-    float invertedValue = 1-value;
-    float nonInvertedValue = value;
-    value = (invert_Param) * invertedValue + (1-invert_Param) * nonInvertedValue;
+    value += invert_Param * (1 - 2 * value);
 }
-
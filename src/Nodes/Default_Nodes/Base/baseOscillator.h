@@ -9,9 +9,7 @@
 #ifndef baseOscillator_h
 #define baseOscillator_h
 
-#ifdef OFXOCEANODE_USE_RANDOMSEED
 #include <random>
-#endif
 
 enum oscTypes{
     sinOsc = 1,
@@ -58,11 +56,12 @@ private:
     float pastRandom;
     float newRandom;
     
+    //Own generator, the oscillators of different nodes can be computed at the same time on the engine threads
 #ifdef OFXOCEANODE_USE_RANDOMSEED
     int seed;
+#endif
     std::mt19937 mt;
     std::uniform_real_distribution<float> dist;
-#endif
 };
 
 #endif /* baseOscillator_h */
@@ -0,0 +1,517 @@
+//
+//  baseOscillatorBank.cpp
+//  ofxOceanode
+//
+
+#include "baseOscillatorBank.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define OSCILLATOR_BANK_SSE2
+#endif
+
+namespace{
+//Minimal float vector used by the kernels, a scalar float when there is no SIMD available
+#if defined(__AVX2__)
+struct floatv{
+    static constexpr int width = 8;
+    __m256 v;
+    floatv(){};
+    floatv(__m256 _v) : v(_v){};
+    floatv(float f) : v(_mm256_set1_ps(f)){};
+    static floatv load(const float *p){return _mm256_loadu_ps(p);};
+    void store(float *p) const{_mm256_storeu_ps(p, v);};
+    friend floatv operator+(floatv a, floatv b){return _mm256_add_ps(a.v, b.v);};
+    friend floatv operator-(floatv a, floatv b){return _mm256_sub_ps(a.v, b.v);};
+    friend floatv operator*(floatv a, floatv b){return _mm256_mul_ps(a.v, b.v);};
+    friend floatv operator/(floatv a, floatv b){return _mm256_div_ps(a.v, b.v);};
+    friend floatv vmin(floatv a, floatv b){return _mm256_min_ps(a.v, b.v);};
+    friend floatv vmax(floatv a, floatv b){return _mm256_max_ps(a.v, b.v);};
+    friend floatv vfloor(floatv a){return _mm256_floor_ps(a.v);};
+    friend floatv vabs(floatv a){return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), a.v);};
+    friend floatv operator<(floatv a, floatv b){return _mm256_cmp_ps(a.v, b.v, _CMP_LT_OQ);};
+    friend floatv operator<=(floatv a, floatv b){return _mm256_cmp_ps(a.v, b.v, _CMP_LE_OQ);};
+    friend floatv operator>(floatv a, floatv b){return _mm256_cmp_ps(a.v, b.v, _CMP_GT_OQ);};
+    //mask ? a : b
+    friend floatv select(floatv mask, floatv a, floatv b){return _mm256_blendv_ps(b.v, a.v, mask.v);};
+    //Exponent and mantissa (1..2) of positive floats, and 2^i for an integer i, from the IEEE 754 bits
+    friend floatv vexponent(floatv a){
+        __m256i bits = _mm256_castps_si256(a.v);
+        return _mm256_cvtepi32_ps(_mm256_sub_epi32(_mm256_srli_epi32(bits, 23), _mm256_set1_epi32(127)));
+    };
+    friend floatv vmantissa(floatv a){
+        __m256i bits = _mm256_castps_si256(a.v);
+        return _mm256_castsi256_ps(_mm256_or_si256(_mm256_and_si256(bits, _mm256_set1_epi32(0x007FFFFF)), _mm256_set1_epi32(0x3F800000)));
+    };
+    friend floatv vexp2i(floatv i){
+        return _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_add_epi32(_mm256_cvttps_epi32(i.v), _mm256_set1_epi32(127)), 23));
+    };
+};
+#elif defined(OSCILLATOR_BANK_SSE2)
+struct floatv{
+    static constexpr int width = 4;
+    __m128 v;
+    floatv(){};
+    floatv(__m128 _v) : v(_v){};
+    floatv(float f) : v(_mm_set1_ps(f)){};
+    static floatv load(const float *p){return _mm_loadu_ps(p);};
+    void store(float *p) const{_mm_storeu_ps(p, v);};
+    friend floatv operator+(floatv a, floatv b){return _mm_add_ps(a.v, b.v);};
+    friend floatv operator-(floatv a, floatv b){return _mm_sub_ps(a.v, b.v);};
+    friend floatv operator*(floatv a, floatv b){return _mm_mul_ps(a.v, b.v);};
+    friend floatv operator/(floatv a, floatv b){return _mm_div_ps(a.v, b.v);};
+    friend floatv vmin(floatv a, floatv b){return _mm_min_ps(a.v, b.v);};
+    friend floatv vmax(floatv a, floatv b){return _mm_max_ps(a.v, b.v);};
+    friend floatv vfloor(floatv a){
+        //SSE2 has no floor, truncate and correct the negative values
+        __m128 truncated = _mm_cvtepi32_ps(_mm_cvttps_epi32(a.v));
+        return _mm_sub_ps(truncated, _mm_and_ps(_mm_cmpgt_ps(truncated, a.v), _mm_set1_ps(1.0f)));
+    };
+    friend floatv vabs(floatv a){return _mm_andnot_ps(_mm_set1_ps(-0.0f), a.v);};
+    friend floatv operator<(floatv a, floatv b){return _mm_cmplt_ps(a.v, b.v);};
+    friend floatv operator<=(floatv a, floatv b){return _mm_cmple_ps(a.v, b.v);};
+    friend floatv operator>(floatv a, floatv b){return _mm_cmpgt_ps(a.v, b.v);};
+    friend floatv select(floatv mask, floatv a, floatv b){return _mm_or_ps(_mm_and_ps(mask.v, a.v), _mm_andnot_ps(mask.v, b.v));};
+    friend floatv vexponent(floatv a){
+        __m128i bits = _mm_castps_si128(a.v);
+        return _mm_cvtepi32_ps(_mm_sub_epi32(_mm_srli_epi32(bits, 23), _mm_set1_epi32(127)));
+    };
+    friend floatv vmantissa(floatv a){
+        __m128i bits = _mm_castps_si128(a.v);
+        return _mm_castsi128_ps(_mm_or_si128(_mm_and_si128(bits, _mm_set1_epi32(0x007FFFFF)), _mm_set1_epi32(0x3F800000)));
+    };
+    friend floatv vexp2i(floatv i){
+        return _mm_castsi128_ps(_mm_slli_epi32(_mm_add_epi32(_mm_cvttps_epi32(i.v), _mm_set1_epi32(127)), 23));
+    };
+};
+#else
+struct floatv{
+    static constexpr int width = 1;
+    float v;
+    floatv(){};
+    floatv(float f) : v(f){};
+    static floatv load(const float *p){return *p;};
+    void store(float *p) const{*p = v;};
+    friend floatv operator+(floatv a, floatv b){return a.v + b.v;};
+    friend floatv operator-(floatv a, floatv b){return a.v - b.v;};
+    friend floatv operator*(floatv a, floatv b){return a.v * b.v;};
+    friend floatv operator/(floatv a, floatv b){return a.v / b.v;};
+    friend floatv vmin(floatv a, floatv b){return std::min(a.v, b.v);};
+    friend floatv vmax(floatv a, floatv b){return std::max(a.v, b.v);};
+    friend floatv vfloor(floatv a){return std::floor(a.v);};
+    friend floatv vabs(floatv a){return std::fabs(a.v);};
+    //Masks are 1 or 0
+    friend floatv operator<(floatv a, floatv b){return a.v < b.v ? 1.0f : 0.0f;};
+    friend floatv operator<=(floatv a, floatv b){return a.v <= b.v ? 1.0f : 0.0f;};
+    friend floatv operator>(floatv a, floatv b){return a.v > b.v ? 1.0f : 0.0f;};
+    friend floatv select(floatv mask, floatv a, floatv b){return mask.v != 0 ? a.v : b.v;};
+    friend floatv vexponent(floatv a);
+    friend floatv vmantissa(floatv a);
+    friend floatv vexp2i(floatv i);
+};
+#endif
+
+inline floatv clamp01(floatv v){
+    return vmin(vmax(v, 0.0f), 1.0f);
+}
+
+//Runs f over blocks of floatv::width elements and the tail with a scalar float, with the same code
+template<typename F>
+inline void forEachBlock(int size, F f){
+    int i = 0;
+    for(; i + floatv::width <= size; i += floatv::width){
+        f(i, floatv());
+    }
+    for(; i < size; i++){
+        f(i, float());
+    }
+}
+
+template<typename T> inline T loadAs(const float *p);
+template<> inline floatv loadAs<floatv>(const float *p){return floatv::load(p);};
+template<> inline float loadAs<float>(const float *p){return *p;};
+inline void storeTo(float *p, floatv v){v.store(p);};
+inline void storeTo(float *p, float v){*p = v;};
+inline float vmin(float a, float b){return std::min(a, b);};
+inline float vmax(float a, float b){return std::max(a, b);};
+inline float vfloor(float v){return std::floor(v);};
+inline float vabs(float v){return std::fabs(v);};
+inline float clamp01(float v){return std::min(std::max(v, 0.0f), 1.0f);};
+inline float select(bool mask, float a, float b){return mask ? a : b;};
+inline float vexponent(float a){
+    uint32_t bits;
+    memcpy(&bits, &a, sizeof(float));
+    return int(bits >> 23) - 127;
+}
+inline float vmantissa(float a){
+    uint32_t bits;
+    memcpy(&bits, &a, sizeof(float));
+    bits = (bits & 0x007FFFFF) | 0x3F800000;
+    memcpy(&a, &bits, sizeof(float));
+    return a;
+}
+inline float vexp2i(float i){
+    uint32_t bits = uint32_t(int(i) + 127) << 23;
+    float result;
+    memcpy(&result, &bits, sizeof(float));
+    return result;
+}
+#if !defined(__AVX2__) && !defined(OSCILLATOR_BANK_SSE2)
+floatv vexponent(floatv a){return vexponent(a.v);};
+floatv vmantissa(floatv a){return vmantissa(a.v);};
+floatv vexp2i(floatv i){return vexp2i(i.v);};
+#endif
+
+//Approximations for the fast math mode, polynomials fitted on Chebyshev nodes. Max errors measured against libm
+//over the ranges the oscillators use (example-oscillatorBenchmark compares whole banks):
+//fastSin: 1.5e-6 absolute, fastLog2: 8.5e-7 absolute, fastExp2: 1.8e-7 relative,
+//fastPow: 1e-5 absolute on 0..1 inputs with the exponents of the Pow and Bi Pow range (1/41..41).
+//Pow with small exponents amplifies any error of its input near 0, with libm too.
+//Whole banks differ from libm by up to 1.1e-6 with sin and cos and 2.5e-5 with Pow or Bi Pow. Sin and cos with negative
+//Pow or Bi Pow differ by up to 0.66 within 1.5e-4 cycles of a trough (or of the middle, for Bi Pow): x^(1/41) turns the float
+//step of the wave there (3e-8 or 6e-8) into 0.65, libm is as far from the exact value. Troughs and peaks are exactly 0 and 1.
+
+//sin(2 pi x), x in cycles. The polynomial is fitted with p(0.25) = 1 and p'(0.25) = 0, in float it gives exactly
+//1 at 0.25 and never more, so the 0..1 waves reach 0 and 1 and negative Pow doesn't lift the troughs
+template<typename T>
+inline T fastSin(T x){
+    //Reduce to -0.25..0.25 cycles, where sin is odd and monotonic
+    T u = x - vfloor(x + T(0.5f));
+    u = select(u > T(0.25f), T(0.5f) - u, u);
+    u = select(u < T(-0.25f), T(-0.5f) - u, u);
+    T s = u * u;
+    return u * (T(6.28314257f) + s * (T(-41.3341599f) + s * (T(81.2394409f) + s * T(-70.0383530f))));
+}
+
+template<typename T>
+inline T fastLog2(T x){
+    T m = vmantissa(x) - T(1.0f);
+    T p = T(-0.0120770203f);
+    p = p * m + T(0.0627484336f);
+    p = p * m + T(-0.154152006f);
+    p = p * m + T(0.255176349f);
+    p = p * m + T(-0.353096353f);
+    p = p * m + T(0.480012461f);
+    p = p * m + T(-0.721306757f);
+    p = p * m + T(1.44269472f);
+    return vexponent(x) + m * p;
+}
+
+template<typename T>
+inline T fastExp2(T y){
+    y = vmax(y, T(-126.0f));
+    T i = vfloor(y);
+    T f = y - i;
+    T p = T(0.00189375406f);
+    p = p * f + T(0.00894959042f);
+    p = p * f + T(0.0558603371f);
+    p = p * f + T(0.240141818f);
+    p = p * f + T(0.693154490f);
+    p = p * f + T(0.999999898f);
+    return vexp2i(i) * p;
+}
+
+//x^e for x in 0..1
+template<typename T>
+inline T fastPow(T x, T e){
+    return select(x > T(0.0f), fastExp2(e * fastLog2(x)), T(0.0f));
+}
+
+//Exponent of the Pow and Bi Pow parameters
+template<typename T>
+inline T powExponent(T p){
+    return select(p < T(0.0f), T(1.0f) / (T(1.0f) - p), p + T(1.0f));
+}
+
+//How the kernels read a parameter (or its coefficients), the same value for all or one value per oscillator
+template<int N>
+struct uniformParameter{
+    float value[N];
+    template<typename T> T get(int i, T) const{return T(value[0]);};
+    template<typename T> T get(int channel, int i, T) const{return T(value[channel]);};
+};
+template<int N>
+struct arrayParameter{
+    const float *values[N];
+    template<typename T> T get(int i, T) const{return loadAs<T>(values[0] + i);};
+    template<typename T> T get(int channel, int i, T) const{return loadAs<T>(values[channel] + i);};
+};
+
+//Calls f with a uniformParameter or arrayParameter for each parameter, so every combination gets its own kernel
+template<typename F>
+inline void withParameters(F f){
+    f();
+}
+
+template<typename F, typename P, typename... Ps>
+inline void withParameters(F f, const P &p, const Ps&... ps){
+    if(p.isUniform()){
+        uniformParameter<P::channels> view;
+        for(int channel = 0; channel < P::channels; channel++){
+            view.value[channel] = p.uniformValue(channel);
+        }
+        withParameters([&](auto... views){f(view, views...);}, ps...);
+    }else{
+        arrayParameter<P::channels> view;
+        for(int channel = 0; channel < P::channels; channel++){
+            view.values[channel] = p.data(channel);
+        }
+        withParameters([&](auto... views){f(view, views...);}, ps...);
+    }
+}
+
+//Waveforms from the phase in cycles, the ones without sin and cos run on the vector width
+template<oscTypes type> struct wave;
+template<> struct wave<sinOsc>{
+    static constexpr bool vectorizable = false;
+    static float compute(float phase){return sinf(phase * (float)TWO_PI) * 0.5f + 0.5f;};
+};
+template<> struct wave<cosOsc>{
+    static constexpr bool vectorizable = false;
+    static float compute(float phase){return cosf(phase * (float)TWO_PI) * 0.5f + 0.5f;};
+};
+template<> struct wave<triOsc>{
+    static constexpr bool vectorizable = true;
+    template<typename T> static T compute(T phase){return T(1.0f) - vabs(T(1.0f) - T(2.0f) * phase);};
+};
+template<> struct wave<squareOsc>{
+    static constexpr bool vectorizable = true;
+    template<typename T> static T compute(T phase){return select(phase > T(0.0f), T(1.0f), T(0.0f));};
+};
+template<> struct wave<sawOsc>{
+    static constexpr bool vectorizable = true;
+    template<typename T> static T compute(T phase){return T(1.0f) - phase;};
+};
+template<> struct wave<sawInvOsc>{
+    static constexpr bool vectorizable = true;
+    template<typename T> static T compute(T phase){return phase;};
+};
+
+//Fast math versions of sin and cos, on the vector width
+struct fastSinWave{
+    static constexpr bool vectorizable = true;
+    template<typename T> static T compute(T phase){return fastSin(phase) * T(0.5f) + T(0.5f);};
+};
+struct fastCosWave{
+    static constexpr bool vectorizable = true;
+    template<typename T> static T compute(T phase){return fastSin(phase + T(0.25f)) * T(0.5f) + T(0.5f);};
+};
+}
+
+baseOscillatorBank::baseOscillatorBank(){
+    waveSelect_Param = 0;
+    fastMath = false;
+    dist = std::uniform_real_distribution<float>(0.0, 1.0);
+}
+
+void baseOscillatorBank::resize(int size){
+    int previousSize = indexNormalized.size();
+    for(auto p : {&phaseOffset_Param, &pow_Param, &pulseWidth_Param, &quant_Param, &scale_Param, &offset_Param, &randomAdd_Param, &biPow_Param, &amplitude_Param, &invert_Param, &skew_Param}){
+        p->resize(size);
+    }
+    computePulseWidthCoefficients();
+    computeSkewCoefficients();
+
+    indexNormalized.resize(size, 0);
+    oldPhasor.resize(size, 0);
+    oldValuePreMod.resize(size, 0);
+    pastRandom.resize(size);
+    newRandom.resize(size);
+    phase.resize(size);
+    std::random_device rd;
+    generators.resize(size);
+    for(int i = previousSize; i < size; i++){
+        generators[i].seed(rd());
+        pastRandom[i] = random(i);
+        newRandom[i] = random(i);
+    }
+}
+
+void baseOscillatorBank::setIndexNormalized(const vector<float> &indexs){
+    for(int i = 0; i < indexNormalized.size() && i < indexs.size(); i++){
+        indexNormalized[i] = indexs[i];
+    }
+}
+
+void baseOscillatorBank::computePulseWidthCoefficients(){
+    //The wave runs in the last pulseWidth part of the cycle: clamp((w - (1 - pulseWidth)) / pulseWidth)
+    //Kept as start and slope, (w - start) * slope loses less precision than w * slope + offset for narrow pulses
+    pulseWidthCoefficients.set(pulseWidth_Param, [](float pulseWidth, float *c){
+        c[0] = 1 - pulseWidth;
+        c[1] = pulseWidth > 0 ? 1 / pulseWidth : 0;
+    });
+}
+
+void baseOscillatorBank::computeSkewCoefficients(){
+    //The skew moves the middle of the cycle to the breakpoint, each half is mapped linearly
+    skewCoefficients.set(skew_Param, [](float skew, float *c){
+        float breakpoint = 0.5f - 0.5f * skew;
+        c[0] = breakpoint;
+        c[1] = breakpoint > 0 ? 0.5f / breakpoint : 0;
+        c[2] = breakpoint < 1 ? 0.5f / (1 - breakpoint) : 0;
+    });
+}
+
+#ifdef OFXOCEANODE_USE_RANDOMSEED
+void baseOscillatorBank::setSeed(int index, int seed){
+    generators[index].seed(seed);
+}
+
+void baseOscillatorBank::deactivateSeed(int index){
+    std::random_device rd;
+    generators[index].seed(rd());
+}
+#endif
+
+float baseOscillatorBank::random(int index){
+    return dist(generators[index]);
+}
+
+template<typename Wave>
+void baseOscillatorBank::computeWave(float *output){
+    computeWave<Wave>(output, std::integral_constant<bool, Wave::vectorizable>());
+}
+
+template<typename Wave>
+void baseOscillatorBank::computeWave(float *output, std::true_type){
+    forEachBlock(size(), [&](int i, auto tag){
+        using T = decltype(tag);
+        storeTo(&output[i], Wave::compute(loadAs<T>(&phase[i])));
+    });
+}
+
+template<typename Wave>
+void baseOscillatorBank::computeWave(float *output, std::false_type){
+    for(int i = 0; i < size(); i++){
+        output[i] = Wave::compute(phase[i]);
+    }
+}
+
+void baseOscillatorBank::computeRand1(float *output){
+    for(int i = 0; i < size(); i++){
+        output[i] = phase[i] < oldPhasor[i] ? random(i) : oldValuePreMod[i];
+    }
+}
+
+void baseOscillatorBank::computeRand2(float *output){
+    for(int i = 0; i < size(); i++){
+        if(phase[i] < oldPhasor[i]){
+            pastRandom[i] = newRandom[i];
+            newRandom[i] = random(i);
+            output[i] = pastRandom[i];
+        }else{
+            output[i] = pastRandom[i] * (1 - phase[i]) + newRandom[i] * phase[i];
+        }
+    }
+}
+
+bool baseOscillatorBank::fastMathAvailable(){
+    return floatv::width > 1;
+}
+
+void baseOscillatorBank::compute(float phasor, float *output){
+    int n = size();
+
+    //Phase of each oscillator, in cycles: offset, pulse width and skew
+    withParameters([&](auto phaseOffset, auto pulseWidth, auto skew){
+        forEachBlock(n, [&](int i, auto tag){
+            using T = decltype(tag);
+            T w = T(phasor) + loadAs<T>(&indexNormalized[i]) + phaseOffset.get(i, tag);
+            w = w - vfloor(w);
+            w = clamp01((w - pulseWidth.get(0, i, tag)) * pulseWidth.get(1, i, tag));
+            T breakpoint = skew.get(0, i, tag);
+            w = select(w <= breakpoint, w * skew.get(1, i, tag), (w - breakpoint) * skew.get(2, i, tag) + T(0.5f));
+            storeTo(&phase[i], w);
+        });
+    }, phaseOffset_Param, pulseWidthCoefficients, skewCoefficients);
+
+    //Wave, the kernel is chosen once for the whole bank
+    switch(static_cast<oscTypes>(waveSelect_Param + 1)){
+        case sinOsc: fastMath ? computeWave<fastSinWave>(output) : computeWave<wave<sinOsc>>(output); break;
+        case cosOsc: fastMath ? computeWave<fastCosWave>(output) : computeWave<wave<cosOsc>>(output); break;
+        case triOsc: computeWave<wave<triOsc>>(output); break;
+        case squareOsc: computeWave<wave<squareOsc>>(output); break;
+        case sawOsc: computeWave<wave<sawOsc>>(output); break;
+        case sawInvOsc: computeWave<wave<sawInvOsc>>(output); break;
+        case rand1Osc: computeRand1(output); break;
+        case rand2Osc: computeRand2(output); break;
+        default: memset(output, 0, n * sizeof(float)); break;
+    }
+    memcpy(oldValuePreMod.data(), output, n * sizeof(float));
+    memcpy(oldPhasor.data(), phase.data(), n * sizeof(float));
+
+    //Modifiers
+    if(!randomAdd_Param.isZero()){
+        for(int i = 0; i < n; i++){
+            float randomAdd = randomAdd_Param.get(i);
+            if(randomAdd != 0) output[i] += randomAdd * random(i);
+        }
+    }
+    withParameters([&](auto scale, auto offset){
+        forEachBlock(n, [&](int i, auto tag){
+            using T = decltype(tag);
+            T value = clamp01(loadAs<T>(&output[i]));
+            value = clamp01(value * scale.get(i, tag) + offset.get(i, tag));
+            storeTo(&output[i], value);
+        });
+    }, scale_Param, offset_Param);
+    if(fastMath){
+        if(!pow_Param.isZero()){
+            withParameters([&](auto powParam){
+                forEachBlock(n, [&](int i, auto tag){
+                    using T = decltype(tag);
+                    T p = powParam.get(i, tag);
+                    T value = loadAs<T>(&output[i]);
+                    storeTo(&output[i], select(vabs(p) > T(0.0f), fastPow(value, powExponent(p)), value));
+                });
+            }, pow_Param);
+        }
+        if(!biPow_Param.isZero()){
+            withParameters([&](auto biPow){
+                forEachBlock(n, [&](int i, auto tag){
+                    using T = decltype(tag);
+                    T p = biPow.get(i, tag);
+                    T value = loadAs<T>(&output[i]) * T(2.0f) - T(1.0f);
+                    T magnitude = fastPow(vabs(value), powExponent(p));
+                    T result = (select(value < T(0.0f), T(0.0f) - magnitude, magnitude) + T(1.0f)) * T(0.5f);
+                    storeTo(&output[i], select(vabs(p) > T(0.0f), result, loadAs<T>(&output[i])));
+                });
+            }, biPow_Param);
+        }
+    }else{
+        if(pow_Param.isUniform() && !pow_Param.isZero()){
+            float exponent = powExponent(pow_Param.value);
+            for(int i = 0; i < n; i++){
+                output[i] = powf(output[i], exponent);
+            }
+        }else if(!pow_Param.isZero()){
+            for(int i = 0; i < n; i++){
+                float p = pow_Param.values[i];
+                if(p != 0) output[i] = powf(output[i], powExponent(p));
+            }
+        }
+        if(!biPow_Param.isZero()){
+            for(int i = 0; i < n; i++){
+                float p = biPow_Param.get(i);
+                if(p == 0) continue;
+                float value = output[i] * 2 - 1;
+                float exponent = powExponent(p);
+                value = value < 0 ? -powf(-value, exponent) : powf(value, exponent);
+                output[i] = (value + 1) * 0.5f;
+            }
+        }
+    }
+    withParameters([&](auto quant, auto amplitude, auto invert){
+        forEachBlock(n, [&](int i, auto tag){
+            using T = decltype(tag);
+            T value = clamp01(loadAs<T>(&output[i]));
+            T steps = quant.get(i, tag);
+            value = clamp01(select(steps < T(255.0f), vfloor(value * steps) / (steps - T(1.0f)), value));
+            value = value * amplitude.get(i, tag);
+            value = value + invert.get(i, tag) * (T(1.0f) - T(2.0f) * value);
+            storeTo(&output[i], value);
+        });
+    }, quant_Param, amplitude_Param, invert_Param);
+}
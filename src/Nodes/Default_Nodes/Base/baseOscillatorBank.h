@@ -0,0 +1,156 @@
+//
+//  baseOscillatorBank.h
+//  ofxOceanode
+//
+
+#ifndef baseOscillatorBank_h
+#define baseOscillatorBank_h
+
+#include "ofMain.h"
+#include "baseOscillator.h"
+#include <type_traits>
+#include <array>
+#include <random>
+
+//A whole bank of baseOscillator computed in one pass. Parameters and state are kept as one array per field
+//(structure of arrays) so the kernels run over contiguous memory, with AVX2 or SSE2 when the compiler targets them
+//and a scalar fallback otherwise. Same results as a baseOscillator per index.
+//Parameters that are equal for all the oscillators are stored once and kept out of the kernels loops.
+class baseOscillatorBank{
+public:
+    baseOscillatorBank();
+
+    void resize(int size);
+    int size(){return indexNormalized.size();};
+
+    void setIndexNormalized(const vector<float> &indexs);
+    //Parameters with a single value (or less values than oscillators) use the first one, like getValueForPosition
+    void setPhaseOffset(const vector<float> &v){phaseOffset_Param.set(v, size());};
+    void setPow(const vector<float> &v){pow_Param.set(v, size());};
+    void setPulseWidth(const vector<float> &v){pulseWidth_Param.set(v, size()); computePulseWidthCoefficients();};
+    void setQuantization(const vector<int> &v){quant_Param.set(v, size());};
+    void setScale(const vector<float> &v){scale_Param.set(v, size());};
+    void setOffset(const vector<float> &v){offset_Param.set(v, size());};
+    void setRandomAdd(const vector<float> &v){randomAdd_Param.set(v, size());};
+    void setBiPow(const vector<float> &v){biPow_Param.set(v, size());};
+    void setAmplitude(const vector<float> &v){amplitude_Param.set(v, size());};
+    void setInvert(const vector<float> &v){invert_Param.set(v, size());};
+    void setSkew(const vector<float> &v){skew_Param.set(v, size()); computeSkewCoefficients();};
+    void setWaveSelect(int i){waveSelect_Param = i;};
+    //Polynomial approximations for sin, cos and pow instead of libm, errors in baseOscillatorBank.cpp.
+    //Only with SIMD, without it they are slower than libm and the bank ignores the setting
+    static bool fastMathAvailable();
+    void setFastMath(bool fast){fastMath = fast && fastMathAvailable();};
+#ifdef OFXOCEANODE_USE_RANDOMSEED
+    void setSeed(int index, int seed);
+    void deactivateSeed(int index);
+#endif
+
+    //output has to have size() elements
+    void compute(float phasor, float *output);
+
+private:
+    //A parameter of the bank. When all the oscillators share the same value (the usual case) only that value is
+    //stored and the kernels take it out of the loop, otherwise it keeps one value per oscillator.
+    struct parameter{
+        parameter(float defaultValue) : value(defaultValue), zero(defaultValue == 0){};
+
+        template<typename T>
+        void set(const vector<T> &source, int size){
+            value = source[0];
+            zero = std::all_of(source.begin(), source.end(), [](T t){return t == 0;});
+            bool uniform = std::all_of(source.begin(), source.begin() + std::min<size_t>(source.size(), size), [this](T t){return t == value;});
+            if(uniform){
+                values.clear();
+                values.shrink_to_fit();
+            }else{
+                values.resize(size);
+                for(int i = 0; i < size; i++){
+                    values[i] = source.size() <= i ? source[0] : source[i];
+                }
+            }
+        }
+        void resize(int size){
+            if(!isUniform()) values.resize(size, value);
+        }
+        bool isUniform() const{return values.empty();};
+        bool isZero() const{return zero;};
+        float get(int index) const{return isUniform() ? value : values[index];};
+        static constexpr int channels = 1;
+        float uniformValue(int channel) const{return value;};
+        const float* data(int channel) const{return values.data();};
+
+        float value;
+        vector<float> values;
+        bool zero;
+    };
+
+    //Values derived from a parameter when it changes, so the kernels only multiply and add. Uniform when the
+    //parameter is.
+    template<int N>
+    struct coefficients{
+        template<typename F>
+        void set(const parameter &source, F compute){
+            compute(source.value, value.data());
+            float computed[N];
+            for(int channel = 0; channel < N; channel++){
+                values[channel].resize(source.values.size());
+                if(source.isUniform()) values[channel].shrink_to_fit();
+            }
+            for(int i = 0; i < source.values.size(); i++){
+                compute(source.values[i], computed);
+                for(int channel = 0; channel < N; channel++){
+                    values[channel][i] = computed[channel];
+                }
+            }
+        }
+        bool isUniform() const{return values[0].empty();};
+        static constexpr int channels = N;
+        float uniformValue(int channel) const{return value[channel];};
+        const float* data(int channel) const{return values[channel].data();};
+
+        std::array<float, N> value;
+        std::array<vector<float>, N> values;
+    };
+    void computePulseWidthCoefficients();
+    void computeSkewCoefficients();
+    float random(int index);
+    template<typename Wave> void computeWave(float *output);
+    template<typename Wave> void computeWave(float *output, std::true_type);
+    template<typename Wave> void computeWave(float *output, std::false_type);
+    void computeRand1(float *output);
+    void computeRand2(float *output);
+
+    //Parameters
+    parameter phaseOffset_Param = parameter(0);
+    parameter pow_Param = parameter(0);
+    parameter pulseWidth_Param = parameter(1);
+    parameter quant_Param = parameter(255);
+    parameter scale_Param = parameter(1);
+    parameter offset_Param = parameter(0);
+    parameter randomAdd_Param = parameter(0);
+    parameter biPow_Param = parameter(0);
+    parameter amplitude_Param = parameter(1);
+    parameter invert_Param = parameter(0);
+    parameter skew_Param = parameter(0);
+    //start, slope
+    coefficients<2> pulseWidthCoefficients;
+    //breakpoint, low slope, high slope
+    coefficients<3> skewCoefficients;
+    int waveSelect_Param;
+    bool fastMath;
+
+    //State
+    vector<float> indexNormalized;
+    vector<float> oldPhasor;
+    vector<float> oldValuePreMod;
+    vector<float> pastRandom;
+    vector<float> newRandom;
+    vector<float> phase;
+
+    //One generator per oscillator, banks of different nodes can be computed at the same time on the engine threads
+    vector<std::mt19937> generators;
+    std::uniform_real_distribution<float> dist;
+};
+
+#endif /* baseOscillatorBank_h */
@@ -12,61 +12,114 @@
 basePhasor::basePhasor(){
     phasor = 0;
     phasorMod = 0;
-    momentaryPhasor = 0;
-    timer.setPeriodicEvent(1000000);
-    startThread();
     bpm_Param = 120.00;
     beatsMult_Param = 1;
     beatsDiv_Param = 1;
     initPhase_Param = 0;
     loop_Param = true;
+    anchorTime = ofxOceanodeClock::now();
+    anchorCycles = 0;
+    anchorFreq = 2;
+    transportOffset = 0;
+    transportRatio = 1;
+    lastCycle = 0;
+    resetTime = -1;
+    clock = ofxOceanodeClock::getShared();
+    transportRestarts = clock->getTransport().restarts;
+    clock->addPhasor(this);
 }
 
 basePhasor::~basePhasor(){
-    stopThread();
-    phasorToSend.close();
-    waitForThread(true);
+    clock->removePhasor(this);
+}
+
+void basePhasor::setClock(shared_ptr<ofxOceanodeClock> _clock){
+    if(_clock == nullptr || _clock == clock) return;
+    //Once removed the old clock thread doesn't advance it anymore, only the new one does
+    clock->removePhasor(this);
+    clock = _clock;
+    transportRestarts = clock->getTransport().restarts;
+    clock->addPhasor(this);
 }
 
 float basePhasor::getPhasor(){
     if(loop_Param){
-        while(phasorToSend.tryReceive(momentaryPhasor));
-        return momentaryPhasor;
+        return phasorOut.load().phase;
     }else{
         return initPhase_Param;
     }
 }
 
 void basePhasor::resetPhasor(){
-    phasor = 0;
+    resetTime = ofxOceanodeClock::now();
 }
 
-void basePhasor::threadedFunction(){
-    while(isThreadRunning()){
-        timer.waitNext();
-        
-        //tue phasor that goes from 0 to 1 at desired frequency
-        double freq = (double)bpm_Param/(double)60;
-        freq = freq * (double)beatsMult_Param;
-        freq = (double)freq / (double)beatsDiv_Param;
-        double increment = (1.0f/(double)((double)(1000.0)/(double)freq));
-        
-        phasor = phasor + increment;
-        if(phasor >= 1){
-            ofNotifyEvent(phasorCycle);
-        }
-        phasor -= (int)phasor;
-        
-        //Assign a copy of the phasor to add initPhase
-        phasorMod = phasor;
-        
-        //take the initPhase_Param as a phase offset param
-        phasorMod += initPhase_Param;
-        phasorMod -= (int)phasorMod;
-        
-        if(loop_Param){
-            phasorToSend.send(std::move(phasorMod));
+void basePhasor::advance(double time){
+    //tue phasor that goes from 0 to 1 at desired frequency
+    double bpm = bpm_Param;
+    double ratio = (double)beatsMult_Param / (double)beatsDiv_Param;
+    double freq = bpm / 60.0 * ratio;
+    
+    ofxOceanodeClock::transport transport = clock->getTransport();
+    bool followsTransport = (float)transport.bpm == (float)bpm;
+    double beats = ofxOceanodeClock::getBeat(transport, time);
+    
+    if(followsTransport && ratio != transportRatio){
+        //Keep the phase continuous, the new ratio applies from now
+        transportOffset += beats * (transportRatio - ratio);
+        transportRatio = ratio;
+    }
+    
+    double reset = resetTime.exchange(-1);
+    if(reset >= 0){
+        reset = min(reset, time);
+        //Phasors reset together with the transport (container reset, midi start) restart exactly on its beat 0,
+        //the transport is restarted and the phasors reset while the clock is locked so they are seen on the same wake
+        if(followsTransport && transport.restarts != transportRestarts){
+            transportOffset = 0;
+        }else{
+            transportOffset = -ofxOceanodeClock::getBeat(transport, reset) * ratio;
         }
+        transportRatio = ratio;
+        anchorTime = reset;
+        anchorCycles = 0;
+        anchorFreq = freq;
+        lastCycle = 0;
+    }else if(!followsTransport && freq != anchorFreq){
+        //Keep the phase continuous, the new frequency applies from now
+        anchorCycles += (time - anchorTime) * anchorFreq;
+        anchorTime = time;
+        anchorFreq = freq;
+    }
+    
+    //Late or missed wakes don't accumulate, phasors with the same anchor and frequency never drift apart
+    double cycles;
+    if(followsTransport){
+        cycles = beats * ratio + transportOffset;
+        //The own timeline stays in sync, leaving the transport keeps the phase continuous
+        anchorCycles = cycles;
+        anchorTime = time;
+        anchorFreq = freq;
+    }else{
+        cycles = anchorCycles + (time - anchorTime) * freq;
+    }
+    //Cycles are never wrapped, a cycle that ends between two wakes is notified even if the phasor was re-anchored
+    double cycle = floor(cycles);
+    if(cycle > lastCycle){
+        ofNotifyEvent(phasorCycle);
+    }
+    lastCycle = cycle;
+    transportRestarts = transport.restarts;
+    phasor = cycles - cycle;
+    
+    //Assign a copy of the phasor to add initPhase
+    phasorMod = phasor;
+    
+    //take the initPhase_Param as a phase offset param
+    phasorMod += initPhase_Param;
+    phasorMod -= (int)phasorMod;
+    
+    if(loop_Param){
+        phasorOut.store(sample{phasorMod, time});
     }
 }
-
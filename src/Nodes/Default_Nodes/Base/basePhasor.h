@@ -9,33 +9,57 @@
 #ifndef basePhasor_h
 #define basePhasor_h
 #include "ofMain.h"
+#include "ofxOceanodeClock.h"
+#include "ofxOceanodeSeqLock.h"
 
-class basePhasor:public ofThread{
+class basePhasor{
 public:
     basePhasor();
     ~basePhasor();
     
-    float  bpm_Param;
-    int    beatsMult_Param;
-    int    beatsDiv_Param;
-    float  initPhase_Param;
-    bool   loop_Param;
+    //Set from any thread, read by the clock thread
+    std::atomic<float>  bpm_Param;
+    std::atomic<int>    beatsMult_Param;
+    std::atomic<int>    beatsDiv_Param;
+    std::atomic<float>  initPhase_Param;
+    std::atomic<bool>   loop_Param;
 
+    struct sample{
+        double phase;
+        double time; //ofxOceanodeClock::now() when it was computed
+    };
+    
     float getPhasor();
+    //Last phase with its timestamp, lock free
+    sample getPhasorSample(){return phasorOut.load();};
     void  resetPhasor();
     
     ofEvent<void> phasorCycle;
     
+    //Phasors start on the process wide clock, containers move the phasors of their nodes to their own clock
+    void setClock(shared_ptr<ofxOceanodeClock> _clock);
+    
+    //Called from the clock thread with the time of the shared timebase
+    void advance(double time);
     
 private:
-    ofTimer timer;
+    shared_ptr<ofxOceanodeClock> clock;
     
-    void threadedFunction() override;
+    //At the bpm of the clock transport the cycles are beats * mult / div + transportOffset, phasors with the
+    //same ratio and offset are locked. At other bpms they are a closed form function of the time since the
+    //anchor, re-anchored when the frequency changes. Cycles are not wrapped, re-anchoring keeps them continuous.
+    double  anchorTime;
+    double  anchorCycles;
+    double  anchorFreq;
+    double  transportOffset;
+    double  transportRatio;
+    double  lastCycle;
+    uint32_t transportRestarts;
+    std::atomic<double> resetTime;
 
     double  phasor;
     double  phasorMod;
-    ofThreadChannel<double> phasorToSend;
-    double momentaryPhasor;
+    ofxOceanodeSeqLock<sample> phasorOut;
 };
 
 #endif /* basePhasor_h */
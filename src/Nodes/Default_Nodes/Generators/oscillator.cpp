@@ -73,9 +73,9 @@ oscillator::oscillator() : ofxOceanodeNodeModel("Oscillator"){
     addOutputParameterToGroupAndInfo(output.set("Output", 0, 0, 1));
     
     
-    listeners.push(phasorIn.newListener(this, &oscillator::phasorInListener));
+    recomputeOnChange(phasorIn);
 }
 
-void oscillator::phasorInListener(float &phasor){
-    output = baseOsc.computeFunc(phasor);
+void oscillator::recompute(){
+    output = baseOsc.computeFunc(phasorIn);
 }
@@ -15,9 +15,10 @@ class oscillator : public ofxOceanodeNodeModel{
 public:
     oscillator();
     ~oscillator(){};
+    
+    void recompute() override;
         
 private:
-    void phasorInListener(float &phasor);
     baseOscillator baseOsc;
     
     ofParameter<float>  phasorIn;
@@ -10,11 +10,8 @@
 
 oscillatorBank::oscillatorBank() : baseIndexer(100, "Oscillator Bank"){
     color = ofColor::blue;
-    oscillators.resize(indexCount);
-    for(int i=0 ; i < indexCount ; i++){
-        oscillators[i].setIndexNormalized(indexs[i]);
-    }
-    result.resize(oscillators.size());
+    bank.resize(indexCount);
+    bank.setIndexNormalized(indexs);
     
     paramListeners.push(phaseOffset_Param.newListener(this, &oscillatorBank::newPhaseOffsetParam));
     paramListeners.push(randomAdd_Param.newListener(this, &oscillatorBank::newRandomAddParam));
@@ -28,6 +25,9 @@ oscillatorBank::oscillatorBank() : baseIndexer(100, "Oscillator Bank"){
     paramListeners.push(waveSelect_Param.newListener(this, &oscillatorBank::newWaveSelectParam));
     paramListeners.push(pulseWidth_Param.newListener(this, &oscillatorBank::newpulseWidthParam));
     paramListeners.push(skew_Param.newListener(this, &oscillatorBank::newSkewParam));
+    paramListeners.push(fastMath_Param.newListener([this](bool &b){
+        bank.setFastMath(b);
+    }));
 
     
     parameters->add(phasorIn.set("Phasor In", 0, 0, 1));
@@ -43,22 +43,25 @@ oscillatorBank::oscillatorBank() : baseIndexer(100, "Oscillator Bank"){
     parameters->add(skew_Param.set("Skew", {0}, {-1}, {1}));
     parameters->add(amplitude_Param.set("Fader", {1}, {0}, {1}));
     parameters->add(invert_Param.set("Invert", {0}, {0}, {1}));
+    if(baseOscillatorBank::fastMathAvailable()){
+        parameters->add(fastMath_Param.set("Fast Math", false));
+    }
 #ifdef OFXOCEANODE_USE_RANDOMSEED
     parameters->add(seed.set("Seed", {0}, {INT_MIN}, {INT_MAX}));
     paramListeners.push(seed.newListener([this](vector<int> &s){
         if(s.size() == 1){
             if(s[0] == 0){
-                for(int i = 0; i < oscillators.size(); i++){
-                    oscillators[i].deactivateSeed();
+                for(int i = 0; i < bank.size(); i++){
+                    bank.deactivateSeed(i);
                 }
             }else{
-                for(int i = 0; i < oscillators.size(); i++){
-                    oscillators[i].setSeed(s[0] + i);
+                for(int i = 0; i < bank.size(); i++){
+                    bank.setSeed(i, s[0] + i);
                 }
             }
         }else{
-            for(int i = 0; i < oscillators.size(); i++){
-                oscillators[i].setSeed(getValueForPosition(s, i));
+            for(int i = 0; i < bank.size(); i++){
+                bank.setSeed(i, getValueForPosition(s, i));
             }
         }
     }));
@@ -67,7 +70,7 @@ oscillatorBank::oscillatorBank() : baseIndexer(100, "Oscillator Bank"){
 
     addOutputParameterToGroupAndInfo(oscillatorOut.set("Oscillator Out", {0}, {0}, {1}));
     
-    phasorInListener = phasorIn.newListener(this, &oscillatorBank::newPhasorIn);
+    recomputeOnChange(phasorIn);
 }
 
 void oscillatorBank::presetRecallBeforeSettingParameters(ofJson &json){
@@ -81,36 +84,33 @@ void oscillatorBank::presetRecallAfterSettingParameters(ofJson &json){
 }
 
 void oscillatorBank::presetHasLoaded(){
-    phasorIn = phasorIn;
+    markDirty();
 }
 
 void oscillatorBank::indexCountChanged(int &newIndexCount){
     baseIndexer::indexCountChanged(newIndexCount);
-    oscillators.resize(newIndexCount);
-    result.resize(newIndexCount);
-    for(int i=0 ; i < newIndexCount ; i++){
-        oscillators[i].setIndexNormalized(indexs[i]);
-        oscillators[i].phaseOffset_Param = getValueForPosition(phaseOffset_Param.get(), i);
-        oscillators[i].randomAdd_Param = getValueForPosition(randomAdd_Param.get(), i);
-        oscillators[i].scale_Param = getValueForPosition(scale_Param.get(), i);
-        oscillators[i].offset_Param = getValueForPosition(offset_Param.get(), i);
-        oscillators[i].pow_Param = getValueForPosition(pow_Param.get(), i);
-        oscillators[i].quant_Param = getValueForPosition(quant_Param.get(), i);
-        oscillators[i].amplitude_Param = getValueForPosition(amplitude_Param.get(), i);
-        oscillators[i].invert_Param = getValueForPosition(invert_Param.get(), i);
-        oscillators[i].biPow_Param = getValueForPosition(biPow_Param.get(), i);
-        oscillators[i].waveSelect_Param = waveSelect_Param;
-        oscillators[i].pulseWidth_Param = getValueForPosition(pulseWidth_Param.get(), i);
-        oscillators[i].skew_Param = getValueForPosition(skew_Param.get(), i);
-    }
+    bank.resize(newIndexCount);
+    bank.setIndexNormalized(indexs);
+    bank.setPhaseOffset(phaseOffset_Param);
+    bank.setRandomAdd(randomAdd_Param);
+    bank.setScale(scale_Param);
+    bank.setOffset(offset_Param);
+    bank.setPow(pow_Param);
+    bank.setQuantization(quant_Param);
+    bank.setAmplitude(amplitude_Param);
+    bank.setInvert(invert_Param);
+    bank.setBiPow(biPow_Param);
+    bank.setWaveSelect(waveSelect_Param);
+    bank.setPulseWidth(pulseWidth_Param);
+    bank.setSkew(skew_Param);
 }
 
 void oscillatorBank::computeBank(float phasor){
-    for(int i = 0; i < oscillators.size(); i++){
-        result[i] = oscillators[i].computeFunc(phasor);
-    }
+    //The bank writes in the next output buffer, nothing is copied to publish it
+    vector<float> &result = outputWriter.resize(bank.size());
+    bank.compute(phasor, result.data());
     if(waveSelect_Param == 6 || waveSelect_Param == 7){
-        auto resultCopy = result;
+        resultCopy = result;
         for(int i = 0 ; i < result.size() ; i++){
             int new_i = (floor(((float)i/((float)result.size())*(float)indexQuant_Param)) * floor(((float)result.size())/(float)indexQuant_Param));
             result[i] = resultCopy[new_i];
@@ -119,84 +119,58 @@ void oscillatorBank::computeBank(float phasor){
 }
 
 void oscillatorBank::newIndexs(){
-    for(int i=0 ; i < oscillators.size() ; i++){
-        oscillators[i].setIndexNormalized(indexs[i]);
-    }
+    bank.setIndexNormalized(indexs);
 }
 
-void oscillatorBank::newPhasorIn(float &f){
-    computeBank(f);
-    oscillatorOut = result;
+void oscillatorBank::recompute(){
+    computeBank(phasorIn);
+    outputWriter.publish(oscillatorOut);
 }
 
 void oscillatorBank::newPowParam(vector<float> &f){
-    for(int i = 0; i < oscillators.size(); i++){
-        oscillators[i].pow_Param = getValueForPosition(f, i);
-    }
+    bank.setPow(f);
 }
 
 void oscillatorBank::newpulseWidthParam(vector<float> &f){
-    for(int i = 0; i < oscillators.size(); i++){
-        oscillators[i].pulseWidth_Param = getValueForPosition(f, i);
-    }
+    bank.setPulseWidth(f);
 }
 
 void oscillatorBank::newPhaseOffsetParam(vector<float> &f){
-    for(int i = 0; i < oscillators.size(); i++){
-        oscillators[i].phaseOffset_Param = getValueForPosition(f, i);
-    }
+    bank.setPhaseOffset(f);
 }
 
 void oscillatorBank::newQuantParam(vector<int> &vi){
-    for(int i = 0; i < oscillators.size(); i++){
-        oscillators[i].quant_Param = getValueForPosition(vi, i);
-    }
+    bank.setQuantization(vi);
 }
 
 void oscillatorBank::newScaleParam(vector<float> &f){
-    for(int i = 0; i < oscillators.size(); i++){
-        oscillators[i].scale_Param = getValueForPosition(f, i);
-    }
+    bank.setScale(f);
 }
 
 void oscillatorBank::newOffsetParam(vector<float> &f){
-    for(int i = 0; i < oscillators.size(); i++){
-        oscillators[i].offset_Param = getValueForPosition(f, i);
-    }
+    bank.setOffset(f);
 }
 
 void oscillatorBank::newRandomAddParam(vector<float> &f){
-    for(int i = 0; i < oscillators.size(); i++){
-        oscillators[i].randomAdd_Param = getValueForPosition(f, i);
-    }
+    bank.setRandomAdd(f);
 }
 
 void oscillatorBank::newWaveSelectParam(int &i){
-    for(auto &oscillator : oscillators){
-        oscillator.waveSelect_Param = i;
-    }
+    bank.setWaveSelect(i);
 }
 
 void oscillatorBank::newAmplitudeParam(vector<float> &f){
-    for(int i = 0; i < oscillators.size(); i++){
-        oscillators[i].amplitude_Param = getValueForPosition(f, i);
-    }
+    bank.setAmplitude(f);
 }
 
 void oscillatorBank::newInvertParam(vector<float> &f){
-    for(int i = 0; i < oscillators.size(); i++){
-        oscillators[i].invert_Param = getValueForPosition(f, i);
-    }
+    bank.setInvert(f);
 }
 
 void oscillatorBank::newSkewParam(vector<float> &f){
-    for(int i = 0; i < oscillators.size(); i++){
-        oscillators[i].skew_Param = getValueForPosition(f, i);
-    }
+    bank.setSkew(f);
 }
 
 void oscillatorBank::newBiPowParam(vector<float> &f){
-    for(int i = 0; i < oscillators.size(); i++){
-        oscillators[i].biPow_Param = getValueForPosition(f, i);
-    }
+    bank.setBiPow(f);
 }
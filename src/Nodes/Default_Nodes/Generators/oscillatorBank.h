@@ -10,7 +10,7 @@
 #define oscillatorBank_h
 
 #include "baseIndexer.h"
-#include "baseOscillator.h"
+#include "baseOscillatorBank.h"
 
 //This class will contain a set of oscillators and has to inherit the indexer class (or bank class)
 class oscillatorBank : public baseIndexer{
@@ -23,6 +23,8 @@ public:
     void presetRecallAfterSettingParameters(ofJson &json) override;
     
     void presetHasLoaded() override;
+    
+    void recompute() override;
 
 private:
     void computeBank(float phasor);
@@ -39,7 +41,6 @@ private:
     }
 
     virtual void newIndexs() override;
-    void newPhasorIn(float &f);
     void newPowParam(vector<float> &f);
     void newpulseWidthParam(vector<float> &f);
     void newHoldTimeParam(vector<float> &f);
@@ -69,16 +70,17 @@ private:
     ofParameter<vector<float>>    amplitude_Param;
     ofParameter<vector<float>>    invert_Param;
     ofParameter<vector<float>>    skew_Param;
-    ofParameter<vector<float>>      oscillatorOut;
+    ofParameter<bool>     fastMath_Param;
+    ofParameter<ofxOceanodeBuffer>      oscillatorOut;
 #ifdef OFXOCEANODE_USE_RANDOMSEED
     ofParameter<vector<int>> seed;
 #endif
     
-    vector<baseOscillator> oscillators;
-    vector<float> result;
+    baseOscillatorBank bank;
+    ofxOceanodeBufferWriter outputWriter;
+    vector<float> resultCopy;
     
     ofEventListeners paramListeners;
-    ofEventListener phasorInListener;
 };
 
 #endif /* oscillatorBank_h */
@@ -23,6 +23,7 @@ public:
     void setBeatDiv(int i){beatsDiv_Param=i;};
     
     void setPhase(float _phase) override;
+    void setClock(shared_ptr<ofxOceanodeClock> clock) override {basePh.setClock(clock);};
 private:
     basePhasor basePh;
     void update(ofEventArgs &e);
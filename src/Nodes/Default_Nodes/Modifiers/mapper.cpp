@@ -17,29 +17,19 @@ mapper::mapper() : ofxOceanodeNodeModel("Mapper"){
     parameters->add(maxOutput.set("MaxOutput", 1.0, 0.0, 1.0));
     addOutputParameterToGroupAndInfo(output.set("Output", {0}, {0}, {1}));
 
-    listeners.push(input.newListener([&](vector<float> &vf){
-        recalculate();
-    }));
-    listeners.push(minInput.newListener([&](float &f){
-        recalculate();
-    }));
-    listeners.push(maxInput.newListener([&](float &f){
-        recalculate();
-    }));
-    listeners.push(minOutput.newListener([&](float &f){
-        recalculate();
-    }));
-    listeners.push(maxOutput.newListener([&](float &f){
-        recalculate();
-    }));
+    recomputeOnChange(input);
+    recomputeOnChange(minInput);
+    recomputeOnChange(maxInput);
+    recomputeOnChange(minOutput);
+    recomputeOnChange(maxOutput);
 }
 
-void mapper::recalculate()
+void mapper::recompute()
 {
-    vector<float> tempOut = input.get();
-    for(auto &f : tempOut){
-       f = ofMap(f,minInput,maxInput,minOutput,maxOutput, true);
+    const ofxOceanodeBuffer &in = input.get();
+    vector<float> &out = outputWriter.resize(in.size());
+    for(int i = 0; i < in.size(); i++){
+        out[i] = ofMap(in[i], minInput, maxInput, minOutput, maxOutput, true);
     }
-    output = tempOut;
+    outputWriter.publish(output);
 }
-
@@ -19,18 +19,18 @@ public:
     mapper();
     ~mapper(){};
     
-    void recalculate();
+    void recompute() override;
 
 private:
     
-    ofEventListeners listeners;
-    
-    ofParameter<vector<float>>  input;
+    ofParameter<ofxOceanodeBuffer>  input;
     ofParameter<float>  minInput;
     ofParameter<float>  maxInput;
     ofParameter<float>  minOutput;
     ofParameter<float>  maxOutput;
-    ofParameter<vector<float>>  output;
+    ofParameter<ofxOceanodeBuffer>  output;
+    
+    ofxOceanodeBufferWriter outputWriter;
 };
 
 
@@ -19,30 +19,19 @@ ranger::ranger() : ofxOceanodeNodeModel("Ranger"){
     parameters->add(MaxOutput.set("MaxOutput", 1.0,  minRange, maxRange));
     addOutputParameterToGroupAndInfo(Output.set("Output", {0}, {minRange}, {maxRange}));
     
-    
-    listeners.push(Input.newListener([&](vector<float> &vf){
-        recalculate();
-    }));
-    listeners.push(MinInput.newListener([&](float &f){
-        recalculate();
-    }));
-    listeners.push(MaxInput.newListener([&](float &f){
-        recalculate();
-    }));
-    listeners.push(MinOutput.newListener([&](float &f){
-        recalculate();
-    }));
-    listeners.push(MaxOutput.newListener([&](float &f){
-        recalculate();
-    }));
+    recomputeOnChange(Input);
+    recomputeOnChange(MinInput);
+    recomputeOnChange(MaxInput);
+    recomputeOnChange(MinOutput);
+    recomputeOnChange(MaxOutput);
 }
 
-void ranger::recalculate()
+void ranger::recompute()
 {
-    vector<float> vFloat = Input.get();
-    for(auto &f : vFloat){
-        f = ofMap(f,MinInput,MaxInput,MinOutput,MaxOutput, true);
+    const ofxOceanodeBuffer &in = Input.get();
+    vector<float> &out = outputWriter.resize(in.size());
+    for(int i = 0; i < in.size(); i++){
+        out[i] = ofMap(in[i], MinInput, MaxInput, MinOutput, MaxOutput, true);
     }
-    Output = vFloat;
+    outputWriter.publish(Output);
 }
-
@@ -22,18 +22,18 @@ public:
 //    float getRange();    
 //    void resetRange();
     
-    void recalculate();
+    void recompute() override;
 
 private:
     
-    ofEventListeners listeners;
-    
-    ofParameter<vector<float>>  Input;
+    ofParameter<ofxOceanodeBuffer>  Input;
     ofParameter<float>  MinInput;
     ofParameter<float>  MaxInput;
     ofParameter<float>  MinOutput;
     ofParameter<float>  MaxOutput;
-    ofParameter<vector<float>>  Output;
+    ofParameter<ofxOceanodeBuffer>  Output;
+    
+    ofxOceanodeBufferWriter outputWriter;
 };
 
 
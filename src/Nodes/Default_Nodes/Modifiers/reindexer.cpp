@@ -15,7 +15,7 @@ reindexer::reindexer() : ofxOceanodeNodeModelExternalWindow("Reindexer"){
     parameters->add(outputSize.set("Output Size", 10, 1, 100));
     addOutputParameterToGroupAndInfo(output.set("Output", {0}, {0}, {1}));
     
-    inputListenerEvent = input.newListener(this, &reindexer::inputListener);
+    recomputeOnChange(input);
     outputSizeListenerEvent = outputSize.newListener(this, &reindexer::outputSizeListener);
     
     isReindexIdentity = true;
@@ -50,7 +50,8 @@ void reindexer::presetRecallAfterSettingParameters(ofJson &json){
     }
 }
 
-void reindexer::inputListener(vector<float> &vf){
+void reindexer::recompute(){
+    const ofxOceanodeBuffer &vf = input.get();
     if(vf.size() != reindexGrid[0].size()){
         outputSize = vf.size();
         identityReindexMatrix = vector<vector<bool>>(vf.size(), vector<bool>(vf.size(), false));
@@ -61,20 +62,21 @@ void reindexer::inputListener(vector<float> &vf){
         reindexGrid = identityReindexMatrix;
     }
     if(isReindexIdentity){
+        //Shares the input buffer
         output = vf;
     }else{
-        vector<float> tempOutput;
-        tempOutput.resize(outputSize, 0);
+        vector<float> &outputBuffer = outputWriter.resize(outputSize);
+        std::fill(outputBuffer.begin(), outputBuffer.end(), 0);
         for(int i = 0; i < outputSize; i++){
-            for(int j = 0; j < input.get().size(); j++){
+            for(int j = 0; j < vf.size(); j++){
                 if(reindexGrid[i][j]){
-                    if(input.get()[j] > tempOutput[i]){
-                        tempOutput[i] = input.get()[j];
+                    if(vf[j] > outputBuffer[i]){
+                        outputBuffer[i] = vf[j];
                     }
                 }
             }
         }
-        output = tempOutput;
+        outputWriter.publish(output);
     }
 }
 
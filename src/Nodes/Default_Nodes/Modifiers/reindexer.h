@@ -18,13 +18,13 @@ public:
     void presetSave(ofJson &json) override;
     void presetRecallAfterSettingParameters(ofJson &json) override;
     
+    void recompute() override;
+    
 private:
     void drawInExternalWindow(ofEventArgs &e) override;
     void keyPressed(ofKeyEventArgs &a) override;
     void mousePressed(ofMouseEventArgs &a) override;
     
-    void inputListener(vector<float> &vf);
-    ofEventListener inputListenerEvent;
     void outputSizeListener(int &f);
     ofEventListener outputSizeListenerEvent;
     
@@ -34,9 +34,10 @@ private:
     bool isReindexIdentity;
     void reindexChanged();
     
-    ofParameter<vector<float>> input;
+    ofParameter<ofxOceanodeBuffer> input;
     ofParameter<int>    outputSize;
-    ofParameter<vector<float>> output;
+    ofParameter<ofxOceanodeBuffer> output;
+    ofxOceanodeBufferWriter outputWriter;
 };
 
 #endif /* reindexer_h */
@@ -14,16 +14,24 @@ smoother::smoother() : ofxOceanodeNodeModel("Smoother"){
     parameters->add(tension.set("Tension", {0}, {-1}, {1}));
     addOutputParameterToGroupAndInfo(output.set("Output", {0}, {0}, {1}));
     
-    inputEventListener = input.newListener(this, &smoother::inputListener);
+    recomputeOnChange(input);
 }
 
-void smoother::inputListener(vector<float> &vf){
-    if(previousInput.size() != vf.size()) previousInput = vf;
-    vector<float> newOutput(vf.size());
+void smoother::recompute(){
+    const ofxOceanodeBuffer &vf = input.get();
+    const vector<float> &vSmoothing = smoothing.get();
+    const vector<float> &vTension = tension.get();
+    //Smooths from the last output, the sinks keep it while the next one is written
+    const ofxOceanodeBuffer &previousInput = output.get();
+    if(previousInput.size() != vf.size()){
+        output = vf;
+        return;
+    }
+    vector<float> &newOutput = outputWriter.resize(vf.size());
     for(int i = 0; i < vf.size(); i++){
-        float smoothingValue = smoothing.get().size() == 1 ? smoothing.get()[0] : smoothing.get()[i];
+        float smoothingValue = vSmoothing.size() == 1 ? vSmoothing[0] : vSmoothing[i];
         float newSmoothing = smoothingValue;
-        float tensionValue = tension.get().size() == 1 ? tension.get()[0] : tension.get()[i];
+        float tensionValue = vTension.size() == 1 ? vTension[0] : vTension[i];
         if(tensionValue > 0)
             newSmoothing = ofClamp(smoothingValue * (1 - (abs(previousInput[i] - vf[i]) * tensionValue)), 0, 1);
         else if(tensionValue < 0)
@@ -31,6 +39,5 @@ void smoother::inputListener(vector<float> &vf){
         
         newOutput[i] = (newSmoothing * previousInput[i]) + ((1 - newSmoothing) * vf[i]);
     }
-    output = newOutput;
-    previousInput = newOutput;
+    outputWriter.publish(output);
 }
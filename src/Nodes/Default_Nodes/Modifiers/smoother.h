@@ -15,15 +15,15 @@ public:
     smoother();
     ~smoother(){};
     
+    void recompute() override;
+    
 private:
-    void inputListener(vector<float> &vf);
-    ofEventListener inputEventListener;
     
-    ofParameter<vector<float>>  input;
+    ofParameter<ofxOceanodeBuffer>  input;
     ofParameter<vector<float>> smoothing;
     ofParameter<vector<float>> tension;
-    ofParameter<vector<float>>  output;
-    vector<float> previousInput;
+    ofParameter<ofxOceanodeBuffer>  output;
+    ofxOceanodeBufferWriter outputWriter;
 };
 
 #endif /* smoother_h */
@@ -15,19 +15,12 @@ switcher::switcher() : ofxOceanodeNodeModel("Switcher Float"){
     parameters->add(input2.set("Input 2", {0}, {0}, {1}));
     addOutputParameterToGroupAndInfo(output.set("Output", {0}, {0}, {1}));
 
-    listeners.push(input1.newListener([&](vector<float> &vf){
-        changedInput(vf);
-    }));
-    listeners.push(input2.newListener([&](vector<float> &vf){
-        changedInput(vf);
-    }));
+    recomputeOnChange(input1);
+    recomputeOnChange(input2);
+    recomputeOnChange(switchSelector);
 }
 
-void switcher::changedSwitch(int &i)
-{
-    
-}
-void switcher::changedInput(vector<float> &vf)
+void switcher::recompute()
 {
     if(switchSelector==0)
     {
@@ -19,17 +19,14 @@ public:
     switcher();
     ~switcher(){};
     
-    void changedSwitch(int &i);
-    void changedInput(vector<float> &f);
+    void recompute() override;
 
 private:
     
-    ofEventListeners listeners;
-    
-    ofParameter<vector<float>>  input1;
-    ofParameter<vector<float>>  input2;
+    ofParameter<ofxOceanodeBuffer>  input1;
+    ofParameter<ofxOceanodeBuffer>  input2;
     ofParameter<int>  switchSelector;
-    ofParameter<vector<float>>  output;
+    ofParameter<ofxOceanodeBuffer>  output;
 };
 
 
@@ -8,6 +8,7 @@
 
 #include "ofxOceanodeNode.h"
 #include "ofxOceanodeContainer.h"
+#include "ofxOceanodeTypesRegistry.h"
 #include "ofxOceanodeNodeModel.h"
 #include "ofxOceanodeNodeGui.h"
 #include "ofxOceanodeConnection.h"
@@ -33,11 +34,21 @@ void ofxOceanodeNode::setup(){
     nodeModel->setup();
 }
 
+void ofxOceanodeNode::update(ofEventArgs &args){
+    nodeModel->update(args);
+    nodeModel->recomputeIfNeeded();
+}
+
+void ofxOceanodeNode::propagateInConnections(){
+    for(auto c : inConnections){
+        c->propagate();
+    }
+}
+
 void ofxOceanodeNode::setGui(std::unique_ptr<ofxOceanodeNodeGui>&& gui){
     nodeGui = std::move(gui);
-    toChangeGuiListeners.push(nodeModel->parameterChangedMinMax.newListener(nodeGui.get(), &ofxOceanodeNodeGui::updateGuiForParameter));
-    toChangeGuiListeners.push(nodeModel->dropdownChanged.newListener(nodeGui.get(), &ofxOceanodeNodeGui::updateDropdown));
-    toChangeGuiListeners.push(nodeModel->parameterGroupChanged.newListener(nodeGui.get(), &ofxOceanodeNodeGui::updateGui));
+    //Ranges and dropdown options reach the gui with its snapshot of the parameters
+    toChangeGuiListeners.push(nodeModel->parameterGroupChanged.newListener(nodeGui.get(), &ofxOceanodeNodeGui::parametersGroupChanged));
 }
 
 ofxOceanodeNodeGui& ofxOceanodeNode::getNodeGui(){
@@ -86,117 +97,7 @@ ofxOceanodeAbstractConnection* ofxOceanodeNode::parameterConnectionRelease(ofxOc
 }
 
 ofxOceanodeAbstractConnection* ofxOceanodeNode::createConnection(ofxOceanodeContainer& container, ofAbstractParameter& sourceParameter, ofAbstractParameter& sinkParameter){
-    ofxOceanodeAbstractConnection* connection = nullptr;
-    ofAbstractParameter& source = sourceParameter;
-    ofAbstractParameter& sink = sinkParameter;
-    if(source.type() == sink.type()){
-        if(source.type() == typeid(ofParameter<int>).name()){
-            connection = container.connectConnection(source.cast<int>(), sink.cast<int>());
-        }
-        else if(source.type() == typeid(ofParameter<float>).name()){
-            connection = container.connectConnection(source.cast<float>(), sink.cast<float>());
-        }
-        else if(source.type() == typeid(ofParameter<bool>).name()){
-            connection = container.connectConnection(source.cast<bool>(), sink.cast<bool>());
-        }
-        else if(source.type() == typeid(ofParameter<void>).name()){
-            connection = container.connectConnection(source.cast<void>(), sink.cast<void>());
-        }
-        else if(source.type() == typeid(ofParameter<vector<float>>).name()){
-            connection = container.connectConnection(source.cast<vector<float>>(), sink.cast<vector<float>>());
-        }
-        else if(source.type() == typeid(ofParameterGroup).name()){
-            connection = container.connectConnection(source.castGroup().getInt(1), sink.castGroup().getInt(1));
-        }
-        else if(source.type() == typeid(ofParameter<vector<int>>).name()){
-            connection = container.connectConnection(source.cast<vector<int>>(), sink.cast<vector<int>>());
-        }
-        else if(source.type() == typeid(ofParameter<short int>).name()){
-            connection = container.connectConnection(source.cast<short int>(), sink.cast<short int>());
-        }
-        else{
-            connection = container.createConnectionFromCustomType(source, sink);
-        }
-    }else if(source.type() == typeid(ofParameter<float>).name()){
-        if(sink.type() == typeid(ofParameter<int>).name()){
-            connection = container.connectConnection(source.cast<float>(), sink.cast<int>());
-        }
-        else if(sink.type() == typeid(ofParameter<vector<float>>).name()){
-            connection = container.connectConnection(source.cast<float>(), sink.cast<vector<float>>());
-        }
-        else if(sink.type() == typeid(ofParameter<vector<int>>).name()){
-            connection = container.connectConnection(source.cast<float>(), sink.cast<vector<int>>());
-        }
-        else if(sink.type() == typeid(ofParameterGroup).name()){
-            connection = container.connectConnection(source.cast<float>(), sink.castGroup().getInt(1));
-        }
-        else if(sink.type() == typeid(ofParameter<bool>).name()){
-            connection = container.connectConnection(source.cast<float>(), sink.cast<bool>());
-        }
-    }else if(source.type() == typeid(ofParameter<int>).name()){
-        if(sink.type() == typeid(ofParameter<float>).name()){
-            connection = container.connectConnection(source.cast<int>(), sink.cast<float>());
-        }
-        else if(sink.type() == typeid(ofParameter<vector<float>>).name()){
-            connection = container.connectConnection(source.cast<int>(), sink.cast<vector<float>>());
-        }
-        else if(sink.type() == typeid(ofParameter<vector<int>>).name()){
-            connection = container.connectConnection(source.cast<int>(), sink.cast<vector<int>>());
-        }
-        else if(sink.type() == typeid(ofParameterGroup).name()){
-            connection = container.connectConnection(source.cast<int>(), sink.castGroup().getInt(1));
-        }
-    }else if(source.type() == typeid(ofParameter<vector<float>>).name()){
-        if(sink.type() == typeid(ofParameter<float>).name()){
-            connection = container.connectConnection(source.cast<vector<float>>(), sink.cast<float>());
-        }
-        else if(sink.type() == typeid(ofParameter<int>).name()){
-            connection = container.connectConnection(source.cast<vector<float>>(), sink.cast<int>());
-        }
-        else if(sink.type() == typeid(ofParameter<vector<int>>).name()){
-            connection = container.connectConnection(source.cast<vector<float>>(), sink.cast<vector<int>>());
-        }
-        else if(sink.type() == typeid(ofParameterGroup).name()){
-            connection = container.connectConnection(source.cast<vector<float>>(), sink.castGroup().getInt(1));
-        }
-    }else if(source.type() == typeid(ofParameter<vector<int>>).name()){
-        if(sink.type() == typeid(ofParameter<float>).name()){
-            connection = container.connectConnection(source.cast<vector<int>>(), sink.cast<float>());
-        }
-        else if(sink.type() == typeid(ofParameter<int>).name()){
-            connection = container.connectConnection(source.cast<vector<int>>(), sink.cast<int>());
-        }
-        else if(sink.type() == typeid(ofParameter<vector<float>>).name()){
-            connection = container.connectConnection(source.cast<vector<int>>(), sink.cast<vector<float>>());
-        }
-        else if(sink.type() == typeid(ofParameterGroup).name()){
-            connection = container.connectConnection(source.cast<vector<int>>(), sink.castGroup().getInt(1));
-        }
-    }else if(source.type() == typeid(ofParameter<void>).name()){
-        if(sink.type() == typeid(ofParameter<bool>).name()){
-            connection = container.connectConnection(source.cast<void>(), sink.cast<bool>());
-        }else if(sink.type() == typeid(ofParameter<int>).name()){
-            connection = container.connectConnection(source.cast<void>(), sink.cast<int>());
-        }else if(sink.type() == typeid(ofParameter<float>).name()){
-            connection = container.connectConnection(source.cast<void>(), sink.cast<float>());
-        }else if(sink.type() == typeid(ofParameter<bool>).name()){
-            connection = container.connectConnection(source.cast<void>(), sink.cast<bool>());
-        }
-    }else if(source.type() == typeid(ofParameterGroup).name()){
-        if(sink.type() == typeid(ofParameter<float>).name()){
-            connection = container.connectConnection(source.castGroup().getInt(1), sink.cast<float>());
-        }
-        else if(sink.type() == typeid(ofParameter<int>).name()){
-            connection = container.connectConnection(source.castGroup().getInt(1), sink.cast<int>());
-        }
-        else if(sink.type() == typeid(ofParameter<vector<float>>).name()){
-            connection = container.connectConnection(source.castGroup().getInt(1), sink.cast<vector<float>>());
-        }
-        else if(sink.type() == typeid(ofParameter<vector<int>>).name()){
-            connection = container.connectConnection(source.castGroup().getInt(1), sink.cast<vector<int>>());
-        }
-    }
-    
+    ofxOceanodeAbstractConnection* connection = container.getTypesRegistry().createConnection(container, sourceParameter, sinkParameter);
     if(connection != nullptr){
         addInputConnection(connection);
     }
@@ -247,22 +148,33 @@ void ofxOceanodeNode::setOutConnectionsPositionForParameter(ofAbstractParameter
 }
 
 void ofxOceanodeNode::addOutputConnection(ofxOceanodeAbstractConnection* c){
+    c->setSourceNode(this);
+    c->setSourceNodeIndex(outConnections.size());
     outConnections.push_back(c);
-    outConnectionsListeners.push(c->destroyConnection.newListener([&, c](){
-        outConnections.erase(std::remove(outConnections.begin(), outConnections.end(), c));
+    outConnectionsListeners.push(c->destroyConnection.newListener([this, c](){
+        int index = c->getSourceNodeIndex();
+        outConnections[index] = outConnections.back();
+        outConnections[index]->setSourceNodeIndex(index);
+        outConnections.pop_back();
     }));
 }
 
 void ofxOceanodeNode::addInputConnection(ofxOceanodeAbstractConnection* c){
+    c->setSinkNode(this);
+    c->setSinkNodeIndex(inConnections.size());
     inConnections.push_back(c);
-    inConnectionsListeners.push(c->destroyConnection.newListener([&, c](){
-        inConnections.erase(std::remove(inConnections.begin(), inConnections.end(), c));
+    inConnectionsListeners.push(c->destroyConnection.newListener([this, c](){
+        int index = c->getSinkNodeIndex();
+        inConnections[index] = inConnections.back();
+        inConnections[index]->setSinkNodeIndex(index);
+        inConnections.pop_back();
     }));
 }
 
 void ofxOceanodeNode::deleteSelf(){
-    inConnections.insert(inConnections.end(), outConnections.begin(), outConnections.end());
-    ofNotifyEvent(deleteModuleAndConnections, inConnections);
+    vector<ofxOceanodeAbstractConnection*> connectionsToDelete = inConnections;
+    connectionsToDelete.insert(connectionsToDelete.end(), outConnections.begin(), outConnections.end());
+    ofNotifyEvent(deleteModuleAndConnections, connectionsToDelete);
 }
 
 void ofxOceanodeNode::duplicateSelf(glm::vec2 posToDuplicate){
@@ -323,35 +235,7 @@ ofJson ofxOceanodeNode::saveParametersToJson(bool persistentPreset){
     for(int i = 0; i < getParameters()->size(); i++){
         ofAbstractParameter& p = getParameters()->get(i);
         if((!persistentPreset && nodeModel->getParameterInfo(p).isSavePreset) || (persistentPreset && nodeModel->getParameterInfo(p).isSaveProject)){
-            if(p.type() == typeid(ofParameter<float>).name()){
-                ofSerialize(json, p);
-            }else if(p.type() == typeid(ofParameter<int>).name()){
-                ofSerialize(json, p);
-            }
-            else if(p.type() == typeid(ofParameter<bool>).name()){
-                ofSerialize(json, p);
-            }
-            else if(p.type() == typeid(ofParameter<ofColor>).name()){
-                ofSerialize(json, p);
-            }
-            else if(p.type() == typeid(ofParameter<string>).name()){
-                ofSerialize(json, p);
-            }
-            else if(p.type() == typeid(ofParameter<vector<float>>).name()){
-                auto vecF = p.cast<vector<float>>().get();
-                if(vecF.size() == 1){
-                    json[p.getEscapedName()] = vecF[0];
-                }
-            }
-            else if(p.type() == typeid(ofParameter<vector<int>>).name()){
-                auto vecI = p.cast<vector<int>>().get();
-                if(vecI.size() == 1){
-                    json[p.getEscapedName()] = vecI[0];
-                }
-            }
-            else if(p.type() == typeid(ofParameterGroup).name()){
-                json[p.getEscapedName()] = p.castGroup().getInt(1).toString();
-            }
+            ofxOceanodeTypesRegistry::serializeParameter(json, p);
         }
     }
     return json;
@@ -361,38 +245,7 @@ bool ofxOceanodeNode::loadParametersFromJson(ofJson json, bool persistentPreset)
         if(getParameters()->contains(it.key())){
             ofAbstractParameter& p = getParameters()->get(it.key());
             if((!persistentPreset && nodeModel->getParameterInfo(p).isSavePreset) || (persistentPreset && nodeModel->getParameterInfo(p).isSaveProject)){
-                if(p.type() == typeid(ofParameter<float>).name()){
-                    ofDeserialize(json, p);
-                }else if(p.type() == typeid(ofParameter<int>).name()){
-                    ofDeserialize(json, p);
-                }
-                else if(p.type() == typeid(ofParameter<bool>).name()){
-                    ofDeserialize(json, p);
-                }
-                else if(p.type() == typeid(ofParameter<ofColor>).name()){
-                    ofDeserialize(json, p);
-                }
-                else if(p.type() == typeid(ofParameter<string>).name()){
-                    ofDeserialize(json, p);
-                }
-                else if(p.type() == typeid(ofParameter<vector<float>>).name()){
-                    float value = 0;
-                    if(it.value().is_string()){
-                        p.cast<vector<float>>() = vector<float>(1, ofToFloat(it.value()));
-                    }else{
-                        p.cast<vector<float>>() = vector<float>(1, float(it.value()));
-                    }
-                }
-                else if(p.type() == typeid(ofParameter<vector<int>>).name()){
-                    if(it.value().is_string()){
-                        p.cast<vector<int>>() = vector<int>(1, ofToInt(it.value()));
-                    }else{
-                        p.cast<vector<int>>() = vector<int>(1, int(it.value()));
-                    }
-                }
-                else if(p.type() == typeid(ofParameterGroup).name()){
-                    p.castGroup().getInt(1).fromString(json[p.getEscapedName()]);
-                }
+                ofxOceanodeTypesRegistry::deserializeParameter(json, p);
             }
         }
     }
@@ -411,13 +264,18 @@ void ofxOceanodeNode::setPhase(float phase){
     nodeModel->setPhase(phase);
 }
 
+void ofxOceanodeNode::setClock(shared_ptr<ofxOceanodeClock> clock){
+    nodeModel->setClock(clock);
+}
+
 void ofxOceanodeNode::resetPhase(){
 #ifdef OFXOCEANODE_USE_RANDOMSEED
     if(getParameters()->contains("Seed")){
         auto &seedp = getParameters()->get("Seed");
-        if(seedp.type() == typeid(ofParameter<int>).name()){
+        int seedType = ofxOceanodeTypesRegistry::getTypeId(seedp);
+        if(seedType == OFXOCEANODE_TYPE_INT){
             seedp.cast<int>() = seedp.cast<int>();
-        }else if(seedp.type() == typeid(ofParameter<vector<int>>).name()){
+        }else if(seedType == OFXOCEANODE_TYPE_VECTOR_INT){
             seedp.cast<vector<int>>() = seedp.cast<vector<int>>();
         }
     }
@@ -15,6 +15,7 @@ class ofxOceanodeAbstractConnection;
 class ofxOceanodeNodeGui;
 class ofxOceanodeNodeModel;
 class ofxOceanodeContainer;
+class ofxOceanodeClock;
 
 class ofxOceanodeNode {
 public:
@@ -22,6 +23,8 @@ public:
     ~ofxOceanodeNode();
     
     void setup();
+    void update(ofEventArgs &args);
+    void propagateInConnections();
     void setGui(std::unique_ptr<ofxOceanodeNodeGui>&& gui);
     
     ofxOceanodeNodeGui& getNodeGui();
@@ -65,6 +68,7 @@ public:
     void setBpm(float bpm);
     void setPhase(float _phase);
     void resetPhase();
+    void setClock(shared_ptr<ofxOceanodeClock> clock);
     
     bool getIsPersistent(){return isPersistent;};
     bool setIsPersistent(bool p){isPersistent = p;};
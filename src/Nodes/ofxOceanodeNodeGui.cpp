@@ -18,8 +18,11 @@ ofxOceanodeNodeGui::ofxOceanodeNodeGui(ofxOceanodeContainer& _container, ofxOcea
 #ifdef OFXOCEANODE_USE_MIDI
     isListeningMidi = false;
 #endif
+    applyingSnapshot = false;
+    parametersChanged = false;
+    guiThreadId = std::this_thread::get_id();
     
-    
+    updateGuiParameters();
     createGuiFromParameters(window);
     if(window == nullptr){
         keyAndMouseListeners.push(ofEvents().keyPressed.newListener(this,&ofxOceanodeNodeGui::keyPressed));
@@ -48,6 +51,205 @@ ofxOceanodeNodeGui::~ofxOceanodeNodeGui(){
     
 }
 
+template<typename T>
+ofParameter<T>& ofxOceanodeNodeGui::addGuiParameter(ofParameterGroup &group, ofParameter<T> &parameter, const string &snapshotName, bool forwardChanges){
+    ofParameter<T> guiParameter;
+    guiParameter.set(parameter.getName(), parameter.get(), parameter.getMin(), parameter.getMax());
+    group.add(guiParameter);
+    
+    //The copies share the value with the parameters, so they stay valid if the node removes them
+    ofParameter<T> nodeParameter = parameter;
+    snapshots[snapshotName].push_back([this, nodeParameter, guiParameter, snapshotName]() mutable{
+        if(guiParameter.getMin() != nodeParameter.getMin() || guiParameter.getMax() != nodeParameter.getMax()){
+            guiParameter.setMin(nodeParameter.getMin());
+            guiParameter.setMax(nodeParameter.getMax());
+            string name = snapshotName;
+            updateGuiForParameter(name);
+        }
+        if(guiParameter.get() != nodeParameter.get()){
+            guiParameter = nodeParameter.get();
+        }
+    });
+    //Sliders write the gui copy, the value is passed to the node parameter
+    if(forwardChanges){
+        guiParametersListeners[snapshotName].push(guiParameter.newListener([this, nodeParameter](T &value) mutable{
+            if(!applyingSnapshot){
+                auto lock = container.lockEngine();
+                nodeParameter = value;
+            }
+        }));
+    }
+    return group.get<T>(parameter.getName());
+}
+
+template<typename T>
+ofParameter<vector<T>>& ofxOceanodeNodeGui::addGuiParameter(ofParameterGroup &group, ofParameter<vector<T>> &parameter, const string &snapshotName, bool forwardChanges){
+    auto preview = [](const vector<T> &source, vector<T> &destination){
+        destination.assign(source.begin(), source.size() > guiVectorPreviewSize ? source.begin() + guiVectorPreviewSize : source.end());
+    };
+    vector<T> value;
+    preview(parameter.get(), value);
+    ofParameter<vector<T>> guiParameter;
+    guiParameter.set(parameter.getName(), value, parameter.getMin(), parameter.getMax());
+    group.add(guiParameter);
+    
+    //Vectors can be large outputs, they are not compared element by element: the node parameter counts its
+    //changes and only a preview is copied, once per frame at most
+    auto version = make_shared<std::atomic<uint64_t>>(0);
+    guiParametersListeners[snapshotName].push(parameter.newListener([version](vector<T> &){
+        (*version)++;
+    }));
+    ofParameter<vector<T>> nodeParameter = parameter;
+    uint64_t copiedVersion = 0;
+    snapshots[snapshotName].push_back([this, nodeParameter, guiParameter, snapshotName, version, copiedVersion, value, preview]() mutable{
+        if(guiParameter.getMin() != nodeParameter.getMin() || guiParameter.getMax() != nodeParameter.getMax()){
+            guiParameter.setMin(nodeParameter.getMin());
+            guiParameter.setMax(nodeParameter.getMax());
+            string name = snapshotName;
+            updateGuiForParameter(name);
+        }
+        uint64_t currentVersion = *version;
+        if(currentVersion != copiedVersion){
+            copiedVersion = currentVersion;
+            preview(nodeParameter.get(), value);
+            guiParameter = value;
+        }
+    });
+    if(forwardChanges){
+        guiParametersListeners[snapshotName].push(guiParameter.newListener([this, nodeParameter](vector<T> &value) mutable{
+            if(!applyingSnapshot){
+                auto lock = container.lockEngine();
+                //A preview would cut the vector
+                if(nodeParameter.get().size() <= guiVectorPreviewSize){
+                    nodeParameter = value;
+                }
+            }
+        }));
+    }
+    return group.get<vector<T>>(parameter.getName());
+}
+
+ofParameter<vector<float>>& ofxOceanodeNodeGui::addGuiParameter(ofParameterGroup &group, ofParameter<ofxOceanodeBuffer> &parameter, const string &snapshotName, bool forwardChanges){
+    auto preview = [](const ofxOceanodeBuffer &source, vector<float> &destination){
+        destination.assign(source.begin(), source.size() > guiVectorPreviewSize ? source.begin() + guiVectorPreviewSize : source.end());
+    };
+    vector<float> value;
+    preview(parameter.get(), value);
+    ofParameter<vector<float>> guiParameter;
+    guiParameter.set(parameter.getName(), value, parameter.getMin().get(), parameter.getMax().get());
+    group.add(guiParameter);
+    
+    //Writers reuse the buffers, so changes are counted like the vectors
+    auto version = make_shared<std::atomic<uint64_t>>(0);
+    guiParametersListeners[snapshotName].push(parameter.newListener([version](ofxOceanodeBuffer &){
+        (*version)++;
+    }));
+    ofParameter<ofxOceanodeBuffer> nodeParameter = parameter;
+    uint64_t copiedVersion = 0;
+    snapshots[snapshotName].push_back([this, nodeParameter, guiParameter, snapshotName, version, copiedVersion, value, preview]() mutable{
+        if(guiParameter.getMin() != nodeParameter.getMin().get() || guiParameter.getMax() != nodeParameter.getMax().get()){
+            guiParameter.setMin(nodeParameter.getMin().get());
+            guiParameter.setMax(nodeParameter.getMax().get());
+            string name = snapshotName;
+            updateGuiForParameter(name);
+        }
+        uint64_t currentVersion = *version;
+        if(currentVersion != copiedVersion){
+            copiedVersion = currentVersion;
+            preview(nodeParameter.get(), value);
+            guiParameter = value;
+        }
+    });
+    if(forwardChanges){
+        guiParametersListeners[snapshotName].push(guiParameter.newListener([this, nodeParameter](vector<float> &value) mutable{
+            if(!applyingSnapshot){
+                auto lock = container.lockEngine();
+                if(nodeParameter.get().size() <= guiVectorPreviewSize){
+                    nodeParameter = ofxOceanodeBuffer(value);
+                }
+            }
+        }));
+    }
+    return group.get<vector<float>>(parameter.getName());
+}
+
+void ofxOceanodeNodeGui::updateGuiParameters(){
+    ofParameterGroup &parameters = *node.getParameters();
+    guiParameters.setName(parameters.getName());
+    for(int i = guiParameters.size() - 1; i >= 0; i--){
+        string name = guiParameters.get(i).getName();
+        if(!parameters.contains(name)){
+            snapshots.erase(name);
+            guiParametersListeners.erase(name);
+            guiParameters.remove(name);
+        }
+    }
+    for(int i = 0; i < parameters.size(); i++){
+        ofAbstractParameter &absParam = parameters.get(i);
+        string name = absParam.getName();
+        if(guiParameters.contains(name)) continue;
+        if(absParam.type() == typeid(ofParameter<float>).name()){
+            addGuiParameter(guiParameters, absParam.cast<float>(), name, true);
+        }else if(absParam.type() == typeid(ofParameter<int>).name()){
+            addGuiParameter(guiParameters, absParam.cast<int>(), name, true);
+        }else if(absParam.type() == typeid(ofParameter<bool>).name()){
+            addGuiParameter(guiParameters, absParam.cast<bool>(), name, false);
+        }else if(absParam.type() == typeid(ofParameter<void>).name()){
+            guiParameters.add(ofParameter<void>().set(name));
+        }else if(absParam.type() == typeid(ofParameter<string>).name()){
+            addGuiParameter(guiParameters, absParam.cast<string>(), name, false);
+        }else if(absParam.type() == typeid(ofParameter<ofColor>).name()){
+            addGuiParameter(guiParameters, absParam.cast<ofColor>(), name, false);
+        }else if(absParam.type() == typeid(ofParameterGroup).name()){
+            ofParameterGroup guiGroup;
+            guiGroup.setName(name);
+            auto &options = addGuiParameter(guiGroup, absParam.castGroup().getString(0), name, false);
+            addGuiParameter(guiGroup, absParam.castGroup().getInt(1), name, false);
+            guiParametersListeners[name].push(options.newListener([this, name](string &){
+                string dropdownName = name;
+                updateDropdown(dropdownName);
+            }));
+            guiParameters.add(guiGroup);
+        }else if(absParam.type() == typeid(ofParameter<vector<float>>).name()){
+            addGuiParameter(guiParameters, absParam.cast<vector<float>>(), name, true);
+        }else if(absParam.type() == typeid(ofParameter<vector<int>>).name()){
+            addGuiParameter(guiParameters, absParam.cast<vector<int>>(), name, true);
+        }else if(absParam.type() == typeid(ofParameter<ofxOceanodeBuffer>).name()){
+            addGuiParameter(guiParameters, absParam.cast<ofxOceanodeBuffer>(), name, true);
+        }else if(absParam.type() == typeid(ofParameter<pair<int, bool>>).name()){
+            addGuiParameter(guiParameters, absParam.cast<pair<int, bool>>(), name, false);
+        }else{
+            //Only a label is shown for the rest of types
+            guiParameters.add(ofParameter<char>().set(name, ' '));
+        }
+    }
+}
+
+void ofxOceanodeNodeGui::updateSnapshot(){
+    if(parametersChanged){
+        parametersChanged = false;
+        updateGuiParameters();
+        updateGui();
+    }
+    applyingSnapshot = true;
+    for(auto &snapshot : snapshots){
+        for(auto &apply : snapshot.second){
+            apply();
+        }
+    }
+    applyingSnapshot = false;
+}
+
+void ofxOceanodeNodeGui::parametersGroupChanged(){
+    //The engine thread can't touch the gui, it is rebuilt on the next gui update
+    if(std::this_thread::get_id() == guiThreadId){
+        updateGuiParameters();
+        updateGui();
+    }else{
+        parametersChanged = true;
+    }
+}
+
 void ofxOceanodeNodeGui::createGuiFromParameters(shared_ptr<ofAppBaseWindow> window){
     ofxDatGuiLog::quiet();
     ofxDatGui::setAssetPath("");
@@ -197,8 +399,8 @@ void ofxOceanodeNodeGui::updateGui(){
         }
     }
     if(removedComponents){
-        for(int i = 0; i < getParameters()->size(); i++){
-            auto &p = getParameters()->get(i);
+        for(int i = 0; i < node.getParameters()->size(); i++){
+            auto &p = node.getParameters()->get(i);
             node.setInConnectionsPositionForParameter(p, getSinkConnectionPositionFromParameter(p));
             node.setOutConnectionsPositionForParameter(p, getSourceConnectionPositionFromParameter(p));
         }
@@ -240,7 +442,7 @@ void ofxOceanodeNodeGui::updateDropdown(string &dropdownName){
 }
 
 ofParameterGroup* ofxOceanodeNodeGui::getParameters(){
-    return node.getParameters();
+    return &guiParameters;
 }
 
 void ofxOceanodeNodeGui::setPosition(glm::vec2 _position){
@@ -321,32 +523,32 @@ void ofxOceanodeNodeGui::mouseReleased(ofMouseEventArgs &args){
 }
 
 void ofxOceanodeNodeGui::onGuiButtonEvent(ofxDatGuiButtonEvent e){
-    getParameters()->getVoid(e.target->getName()).trigger();
+    node.getParameters()->getVoid(e.target->getName()).trigger();
 }
 void ofxOceanodeNodeGui::onGuiToggleEvent(ofxDatGuiToggleEvent e){
-    getParameters()->getBool(e.target->getName()) = e.checked;
+    node.getParameters()->getBool(e.target->getName()) = e.checked;
 }
 
 void ofxOceanodeNodeGui::onGuiDropdownEvent(ofxDatGuiDropdownEvent e){
-    getParameters()->getGroup(e.target->getName()).getInt(1) = e.child;
+    node.getParameters()->getGroup(e.target->getName()).getInt(1) = e.child;
 }
 
 void ofxOceanodeNodeGui::onGuiTextInputEvent(ofxDatGuiTextInputEvent e){
-    getParameters()->getString(e.target->getName()) = e.text;
+    node.getParameters()->getString(e.target->getName()) = e.text;
 }
 
 void ofxOceanodeNodeGui::onGuiColorPickerEvent(ofxDatGuiColorPickerEvent e){
-    getParameters()->getColor(e.target->getName()) = e.color;
+    node.getParameters()->getColor(e.target->getName()) = e.color;
 }
 
 void ofxOceanodeNodeGui::onGuiMatrixEvent(ofxDatGuiMatrixEvent e){
-    getParameters()->get(e.target->getName()).cast<pair<int, bool>>() = make_pair(e.child+1, e.enabled);
+    node.getParameters()->get(e.target->getName()).cast<pair<int, bool>>() = make_pair(e.child+1, e.enabled);
 }
 
 void ofxOceanodeNodeGui::onGuiRightClickEvent(ofxDatGuiRightClickEvent e){
-    ofAbstractParameter *p = &getParameters()->get(e.target->getName());
+    ofAbstractParameter *p = &node.getParameters()->get(e.target->getName());
     if(e.target->getType() == ofxDatGuiType::DROPDOWN){
-        p = &getParameters()->getGroup(e.target->getName()).getInt(1);
+        p = &node.getParameters()->getGroup(e.target->getName()).getInt(1);
     }
 #ifdef OFXOCEANODE_USE_MIDI
     if(isListeningMidi){
@@ -370,7 +572,7 @@ void ofxOceanodeNodeGui::onGuiRightClickEvent(ofxDatGuiRightClickEvent e){
         }else{
             auto connection = node.parameterConnectionRelease(container, *p);
             if(connection != nullptr){
-                connection->setSinkPosition(getSinkConnectionPositionFromParameter(getParameters()->get(e.target->getName())));
+                connection->setSinkPosition(getSinkConnectionPositionFromParameter(*p));
                 connection->setTransformationMatrix(transformationMatrix);
             }
         }
@@ -9,6 +9,7 @@
 #define ofxOceanodeNodeGui_h
 
 #include "ofxDatGui.h"
+#include "ofxOceanodeBuffer.h"
 
 class ofxOceanodeContainer;
 class ofxOceanodeNode;
@@ -20,6 +21,10 @@ public:
     ~ofxOceanodeNodeGui();
     
     void createGuiFromParameters(shared_ptr<ofAppBaseWindow> window);
+    //The gui is built from a copy of the node parameters that only the gui thread touches, so the window
+    //can draw while the engine ticks. updateSnapshot copies the node values to it, with the engine locked.
+    void updateSnapshot();
+    void parametersGroupChanged();
     void updateGui();
     void updateGuiForParameter(string &parameterName);
     void updateDropdown(string &dropdownName);
@@ -63,10 +68,27 @@ private:
     void newModuleListener(ofxDatGuiDropdownEvent e);
     void newPresetListener(ofxDatGuiTextInputEvent e);
     
+    void updateGuiParameters();
+    template<typename T>
+    ofParameter<T>& addGuiParameter(ofParameterGroup &group, ofParameter<T> &parameter, const string &snapshotName, bool forwardChanges);
+    template<typename T>
+    ofParameter<vector<T>>& addGuiParameter(ofParameterGroup &group, ofParameter<vector<T>> &parameter, const string &snapshotName, bool forwardChanges);
+    //Buffers are shown as vectors, with the same preview
+    ofParameter<vector<float>>& addGuiParameter(ofParameterGroup &group, ofParameter<ofxOceanodeBuffer> &parameter, const string &snapshotName, bool forwardChanges);
+    //Vectors longer than this are shown by their first elements and can't be edited from the gui
+    static constexpr size_t guiVectorPreviewSize = 256;
+    
     ofEventListeners keyAndMouseListeners;
     ofEventListeners parameterChangedListeners;
     ofEventListener transformMatrixListener;
     
+    ofParameterGroup guiParameters;
+    std::map<string, vector<std::function<void()>>> snapshots;
+    std::map<string, ofEventListeners> guiParametersListeners;
+    bool applyingSnapshot;
+    std::atomic<bool> parametersChanged;
+    std::thread::id guiThreadId;
+    
     ofxOceanodeContainer& container;
     
     ofxOceanodeNode& node;
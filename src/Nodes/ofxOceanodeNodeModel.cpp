@@ -13,6 +13,14 @@ ofxOceanodeNodeModel::ofxOceanodeNodeModel(string _name) : nameIdentifier(_name)
     autoBPM = true;
     color = ofColor(ofRandom(255), ofRandom(255), ofRandom(255));
     numIdentifier = -1;
+    dirty = false;
+    drawOverridden = true;
+}
+
+void ofxOceanodeNodeModel::recomputeIfNeeded(){
+    if(dirty.exchange(false)){
+        recompute();
+    }
 }
 
 void ofxOceanodeNodeModel::setNumIdentifier(unsigned int num){
@@ -20,13 +28,20 @@ void ofxOceanodeNodeModel::setNumIdentifier(unsigned int num){
     parameters->setName(nameIdentifier + " " + ofToString(num));
 }
 
-void ofxOceanodeNodeModel::registerLoop(shared_ptr<ofAppBaseWindow> w){
+void ofxOceanodeNodeModel::registerLoop(shared_ptr<ofAppBaseWindow> w, std::function<std::unique_lock<std::recursive_timed_mutex>()> lockEngine){
+    auto drawListener = [this, lockEngine](ofEventArgs &e){
+        if(!drawOverridden) return;
+        if(lockEngine != nullptr){
+            auto lock = lockEngine();
+            draw(e);
+        }else{
+            draw(e);
+        }
+    };
     if(w == nullptr){
-        eventListeners.push(ofEvents().draw.newListener(this, &ofxOceanodeNodeModel::draw));
-        eventListeners.push(ofEvents().update.newListener(this, &ofxOceanodeNodeModel::update));
+        eventListeners.push(ofEvents().draw.newListener(drawListener));
     }else{
-        eventListeners.push(w->events().draw.newListener(this, &ofxOceanodeNodeModel::draw));
-        eventListeners.push(w->events().update.newListener(this, &ofxOceanodeNodeModel::update));
+        eventListeners.push(w->events().draw.newListener(drawListener));
     }
 }
 
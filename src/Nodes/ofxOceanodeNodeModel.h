@@ -10,9 +10,11 @@
 #define ofxOceanodeNodeModel_h
 
 #include "ofMain.h"
+#include "ofxOceanodeBuffer.h"
 
 class ofxOceanodeContainer;
 class ofxOceanodeAbstractConnection;
+class ofxOceanodeClock;
 
 struct parameterInfo{
     bool isSavePreset;
@@ -32,8 +34,16 @@ public:
     virtual ~ofxOceanodeNodeModel(){};
     
     virtual void setup(){};
+    //update is called from the container engine tick, draw from the window draw loop with the engine locked,
+    //so it can read the node state. The engine waits while a node draws, keep it short
     virtual void update(ofEventArgs &e){};
-    virtual void draw(ofEventArgs &e){};
+    virtual void draw(ofEventArgs &e){drawOverridden = false;};
+    
+    //Nodes that depend on several inputs can opt in to be computed once per tick:
+    //register the inputs with recomputeOnChange and do the work in recompute
+    virtual void recompute(){};
+    void markDirty(){dirty = true;};
+    void recomputeIfNeeded();
     
     //get parameterGroup
     ofParameterGroup* getParameterGroup(){return parameters;};
@@ -48,11 +58,13 @@ public:
     ofEvent<void> parameterGroupChanged;
     ofEvent<string> disconnectConnectionsForParameter;
     
-    void registerLoop(shared_ptr<ofAppBaseWindow> w = nullptr);
+    void registerLoop(shared_ptr<ofAppBaseWindow> w = nullptr, std::function<std::unique_lock<std::recursive_timed_mutex>()> lockEngine = nullptr);
     
     bool getAutoBPM(){return autoBPM;};
     virtual void setBpm(float _bpm){};
     virtual void setPhase(float _phase){};
+    //Clock of the container the node lives in, nodes with phasors move them to it
+    virtual void setClock(shared_ptr<ofxOceanodeClock> clock){};
     
     virtual void presetSave(ofJson &json){};
     virtual void presetRecallBeforeSettingParameters(ofJson &json){};
@@ -85,6 +97,13 @@ public:
     }
     
 protected:
+    template<typename T>
+    void recomputeOnChange(ofParameter<T> &p){
+        recomputeListeners.push(p.newListener([this](T &){
+            markDirty();
+        }));
+    }
+    
     ofParameterGroup* parameters;
     std::map<string, parameterInfo> parametersInfo; //information about interaction of parameter
     bool autoBPM;
@@ -94,6 +113,9 @@ protected:
     
 private:
     ofEventListeners eventListeners;
+    ofEventListeners recomputeListeners;
+    std::atomic<bool> dirty;
+    bool drawOverridden; //Models that don't draw don't lock the engine every frame
 };
 
 #endif /* ofxOceanodeNodeModel_h */